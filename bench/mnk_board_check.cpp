@@ -0,0 +1,220 @@
+/**
+ * @file mnk_board_check.cpp
+ * @brief Random-game cross-check of the m,n,k engine against the boards it replaces
+ * @details Checks MNK_Lines against a cell-by-cell line count on several board
+ *          sizes, then plays random games on MNKBoard under each rule hook and
+ *          compares every move with an independent implementation:
+ *          - GRAVITY against Connect_4_Position (landing cell and winning move)
+ *          - VANISH_EVERY against Infinity_State (vanished cell and marks)
+ *          - MISERE against a direct line scan (the player completing a line loses)
+ *          - SCORING with MOVE_LIMIT against a direct line count (5x5 scoring rules)
+ *          - unplay() against the position before the move
+ *          Prints one line per check and exits with status 1 on the first mismatch.
+ *
+ *          Usage: mnk_board_check [games per rule]
+ */
+
+#include "MNK_Board.h"
+#include "Connect_4.h"
+#include "Game_Random.h"
+#include "InfinityTicTacToe.h"
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * @brief Complete lines of K marks, counted one start cell and direction at a time
+ */
+template <int M, int N, int K>
+static int count_lines_by_cells(typename MNK_Lines<M, N, K>::Bits marks) {
+    int count = 0;
+    for (int row = 0; row < M; row++) {
+        for (int col = 0; col < N; col++) {
+            for (const auto& step : LINE_DIRECTIONS) {
+                bool complete = true;
+                for (int k = 0; k < K && complete; k++) {
+                    int r = row + k * step[0], c = col + k * step[1];
+                    complete = r >= 0 && r < M && c >= 0 && c < N && ((marks >> (r * N + c)) & 1);
+                }
+                count += complete;
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Report a failed check and stop
+ */
+static void fail(const char* check, int game) {
+    printf("%s: mismatch in game %d\n", check, game);
+    exit(1);
+}
+
+/**
+ * @brief Uniformly random set bit of a non-empty bitboard
+ */
+template <class Bits>
+static int random_bit(Bits bits, Game_Random& rng) {
+    for (int skip = int(rng.below(uint32_t(mnk_popcount(bits)))); skip > 0; skip--)
+        bits &= bits - 1;
+    return mnk_lowest(bits);
+}
+
+/**
+ * @brief Compare count_lines, has_line and has_line_through with the cell-by-cell count on random boards
+ */
+template <int M, int N, int K>
+static void check_lines(int boards, Game_Random& rng) {
+    using Lines = MNK_Lines<M, N, K>;
+    using Bits = typename Lines::Bits;
+
+    for (int t = 0; t < boards; t++) {
+        Bits marks = 0;
+        for (int cell = 0; cell < M * N; cell++)
+            if (rng.below(100) < 60) marks |= Bits(1) << cell;
+
+        int expected = count_lines_by_cells<M, N, K>(marks);
+        if (Lines::count_lines(marks) != expected || Lines::has_line(marks) != (expected > 0))
+            fail("lines", t);
+
+        int cell = int(rng.below(M * N));
+        bool through = false;
+        for (Bits mask : MNK_LINE_TABLE<M, N, K>.masks)
+            if (((mask >> cell) & 1) && (marks & mask) == mask) through = true;
+        if (MNK_LINE_TABLE<M, N, K>.has_line_through(marks, cell) != through)
+            fail("lines through a cell", t);
+    }
+    printf("lines %2dx%-2d k=%d  %3d lines, %2d-bit board: ok\n", M, N, K, Lines::COUNT, int(sizeof(Bits)) * 8);
+}
+
+/// Connect Four: marks drop to the lowest empty cell of their column
+struct Gravity_Rules : MNK_Rules {
+    static constexpr bool GRAVITY = true;
+};
+
+/// Infinity Tic-Tac-Toe: the oldest mark vanishes after every third move
+struct Vanish_Rules : MNK_Rules {
+    static constexpr int VANISH_EVERY = 3;
+};
+
+/// Misere Tic-Tac-Toe: completing a line loses
+struct Misere_Rules : MNK_Rules {
+    static constexpr bool MISERE = true;
+};
+
+/// 5x5 Tic-Tac-Toe: 24 moves are played, then more lines wins
+struct Scoring_Rules : MNK_Rules {
+    static constexpr bool SCORING = true;
+    static constexpr int MOVE_LIMIT = 24;
+};
+
+/**
+ * @brief Random Connect Four games on MNKBoard<6, 7, 4> and Connect_4_Position side by side
+ */
+static void check_gravity(int games, Game_Random& rng) {
+    for (int t = 0; t < games; t++) {
+        MNKBoard<6, 7, 4, Gravity_Rules> board;
+        Connect_4_Position reference;
+        while (!board.is_over()) {
+            int cell = random_bit(board.legal_moves(), rng);
+            int col = cell % 7;
+            if (board.drop(col) != cell || !reference.can_play(col)) fail("gravity landing cell", t);
+
+            bool wins = reference.is_winning_move(col);
+            int mover = board.side_to_move();
+            reference.play(col);
+            board.play(cell);
+            if (wins != (board.winner() == mover)) fail("gravity winner", t);
+        }
+    }
+    printf("gravity        vs Connect_4_Position, %d games: ok\n", games);
+}
+
+/**
+ * @brief Random Infinity games on MNKBoard<3, 3, 3> and Infinity_State side by side
+ */
+static void check_vanish(int games, Game_Random& rng) {
+    for (int t = 0; t < games; t++) {
+        MNKBoard<3, 3, 3, Vanish_Rules> board;
+        Infinity_State reference;
+        for (int move = 0; move < 13 && !board.is_over(); move++) {
+            if (board.legal_moves() != (0x1FF & ~reference.occupied())) fail("vanish empty cells", t);
+
+            int cell = random_bit(board.legal_moves(), rng);
+            if (board.play(cell) != reference.place(cell)) fail("vanish vanished cell", t);
+            if (board.marks(1 - board.side_to_move()) != reference.last_mover()) fail("vanish marks", t);
+        }
+    }
+    printf("vanish         vs Infinity_State, %d games: ok\n", games);
+}
+
+/**
+ * @brief Random 3x3 misere games: the first player to complete a line loses
+ */
+static void check_misere(int games, Game_Random& rng) {
+    for (int t = 0; t < games; t++) {
+        MNKBoard<3, 3, 3, Misere_Rules> board;
+        int loser = -1;
+        while (loser < 0 && board.legal_moves()) {
+            int mover = board.side_to_move();
+            board.play(random_bit(board.legal_moves(), rng));
+            if (count_lines_by_cells<3, 3, 3>(board.marks(mover)) > 0) loser = mover;
+            if (board.is_over() != (loser >= 0 || !board.legal_moves())) fail("misere game over", t);
+        }
+        if (board.winner() != (loser < 0 ? -1 : 1 - loser)) fail("misere winner", t);
+    }
+    printf("misere         vs line scan, %d games: ok\n", games);
+}
+
+/**
+ * @brief Random 5x5 scoring games, with every move also taken back and replayed
+ */
+static void check_scoring(int games, Game_Random& rng) {
+    using Board = MNKBoard<5, 5, 3, Scoring_Rules>;
+    for (int t = 0; t < games; t++) {
+        Board board;
+        while (!board.is_over()) {
+            if (board.moves() >= Scoring_Rules::MOVE_LIMIT || board.winner() != -1) fail("scoring game over", t);
+
+            Board before = board;
+            int cell = random_bit(board.legal_moves(), rng);
+            board.play(cell);
+            Board undone = board;
+            undone.unplay(cell);
+            if (undone.marks(0) != before.marks(0) || undone.marks(1) != before.marks(1) ||
+                undone.moves() != before.moves())
+                fail("unplay", t);
+        }
+        if (board.moves() != Scoring_Rules::MOVE_LIMIT) fail("scoring move limit", t);
+
+        int first = count_lines_by_cells<5, 5, 3>(board.marks(0));
+        int second = count_lines_by_cells<5, 5, 3>(board.marks(1));
+        if (board.winner() != (first > second ? 0 : second > first ? 1 : -1)) fail("scoring winner", t);
+
+        Board rebuilt(board.marks(0), board.marks(1));
+        if (rebuilt.moves() != board.moves() || rebuilt.winner() != board.winner()) fail("position from marks", t);
+    }
+    printf("scoring        vs line count, %d games: ok\n", games);
+}
+
+int main(int argc, char** argv) {
+    int games = argc > 1 ? atoi(argv[1]) : 20000;
+    Game_Random rng(5);
+
+    check_lines<3, 3, 3>(games, rng);
+    check_lines<5, 5, 3>(games, rng);
+    check_lines<6, 6, 4>(games, rng);
+    check_lines<6, 7, 4>(games, rng);
+    check_lines<7, 3, 4>(games, rng);
+    check_lines<1, 8, 3>(games, rng);
+#if defined(__SIZEOF_INT128__)
+    check_lines<10, 10, 5>(games, rng);
+    check_lines<11, 11, 5>(games, rng);
+#endif
+
+    check_gravity(games, rng);
+    check_vanish(games, rng);
+    check_misere(games, rng);
+    check_scoring(games, rng);
+    return 0;
+}
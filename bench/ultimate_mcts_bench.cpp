@@ -0,0 +1,68 @@
+/**
+ * @file ultimate_mcts_bench.cpp
+ * @brief Playout throughput benchmark for the Ultimate Tic Tac Toe MCTS engine
+ * @details Searches the opening position and a mid-game position with 1, 2, 4,
+ *          8 and 16 threads in tree-parallel and root-parallel mode and prints
+ *          playouts per second and the speed-up over one thread.
+ *
+ *          Usage: ultimate_mcts_bench [milliseconds per search]
+ */
+
+#include "UltimateTicTacToe.h"
+#include <cstdio>
+#include <thread>
+
+/**
+ * @brief Build a mid-game position by playing a fixed sequence of moves
+ */
+static Ultimate_TTT_Bitboard midgame_position() {
+    Ultimate_TTT_Bitboard pos;
+    const int moves[] = { 40, 36, 4, 44, 76, 52, 72, 0, 1, 9, 2, 18 };
+    for (int move : moves) {
+        if (pos.is_legal(move / 9, move % 9))
+            pos.play(move / 9, move % 9);
+    }
+    return pos;
+}
+
+/**
+ * @brief Time one search and return its playouts per second
+ */
+static double measure(const Ultimate_TTT_Bitboard& pos, int threads, bool root_parallel, int millis) {
+    Ultimate_TTT_MCTS_Config config;
+    config.threads = threads;
+    config.root_parallel = root_parallel;
+    config.time_limit_ms = millis;
+    config.max_playouts = 1LL << 40;
+    config.max_nodes = 1 << 22;
+
+    Ultimate_TTT_MCTS engine(config, 12345);
+    engine.search(pos);
+    return engine.get_stats().playouts_per_second();
+}
+
+int main(int argc, char** argv) {
+    int millis = argc > 1 ? atoi(argv[1]) : 2000;
+    const int thread_counts[] = { 1, 2, 4, 8, 16 };
+    const struct { const char* name; Ultimate_TTT_Bitboard pos; } positions[] = {
+        { "opening", Ultimate_TTT_Bitboard() },
+        { "midgame", midgame_position() },
+    };
+
+    printf("Hardware threads: %u, %d ms per search\n\n", thread::hardware_concurrency(), millis);
+    for (const auto& position : positions) {
+        for (bool root_parallel : { false, true }) {
+            printf("%s, %s parallel\n", position.name, root_parallel ? "root" : "tree");
+            printf("%8s %16s %10s\n", "threads", "playouts/s", "speed-up");
+            double base = 0;
+            for (int threads : thread_counts) {
+                double rate = measure(position.pos, threads, root_parallel, millis);
+                if (threads == 1)
+                    base = rate;
+                printf("%8d %16.0f %9.2fx\n", threads, rate, base > 0 ? rate / base : 0);
+            }
+            printf("\n");
+        }
+    }
+    return 0;
+}
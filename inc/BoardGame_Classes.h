@@ -179,6 +179,9 @@ class UI {
 protected:
     int cell_width; ///< Width of each displayed board cell
 
+    /// Player types offered by setup_players(): 1 human, 2 computer, 3 AI when listed
+    vector<string> player_type_options = { "Human", "Computer" };
+
     /**
      * @brief Ask the user for the player's name.
      */
@@ -191,6 +194,8 @@ protected:
 
     /**
      * @brief Ask the user to choose the player type from a list.
+     *
+     * Choice 2 is a computer player and choice 3, when offered, an AI player.
      */
     virtual PlayerType get_player_type_choice(string player_label, const vector<string>& options) {
         cout << "Choose " << player_label << " type:\n";
@@ -198,7 +203,9 @@ protected:
             cout << i + 1 << ". " << options[i] << "\n";
         int choice;
         cin >> choice;
-        return (choice == 2) ? PlayerType::COMPUTER : PlayerType::HUMAN;
+        if (choice == 2) return PlayerType::COMPUTER;
+        if (choice == 3 && options.size() >= 3) return PlayerType::AI;
+        return PlayerType::HUMAN;
     }
 
 public:
@@ -325,14 +332,13 @@ public:
 template <typename T>
 Player<T>** UI<T>::setup_players() {
     Player<T>** players = new Player<T>*[2];
-    vector<string> type_options = { "Human", "Computer" };
 
     string nameX = get_player_name("Player X");
-    PlayerType typeX = get_player_type_choice("Player X", type_options);
+    PlayerType typeX = get_player_type_choice("Player X", player_type_options);
     players[0] = create_player(nameX, static_cast<T>('X'), typeX);
 
     string nameO = get_player_name("Player O");
-    PlayerType typeO = get_player_type_choice("Player O", type_options);
+    PlayerType typeO = get_player_type_choice("Player O", player_type_options);
     players[1] = create_player(nameO, static_cast<T>('O'), typeO);
 
     return players;
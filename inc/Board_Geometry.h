@@ -0,0 +1,125 @@
+/**
+ * @file Board_Geometry.h
+ * @brief Dense cell indexing and k-in-a-row lines for non-rectangular boards
+ * @details A shaped board (pyramid, diamond, ...) is drawn as rows of '.'
+ *          (playable) and '#' (outside the board). Board_Geometry numbers the
+ *          playable cells 0..N-1 in reading order, so a position is a pair of
+ *          N-bit bitboards, and generates every straight line of k playable
+ *          cells as a bitmask. Both are constexpr, so a board declares its
+ *          geometry and line tables once at namespace scope and pays nothing
+ *          at run time. Up to 64 playable cells are supported.
+ */
+
+#ifndef BOARD_GEOMETRY_H
+#define BOARD_GEOMETRY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+/// Row and column step of each line direction: horizontal, vertical, diagonal, anti-diagonal
+inline constexpr int LINE_DIRECTIONS[4][2] = { { 0, 1 }, { 1, 0 }, { 1, 1 }, { 1, -1 } };
+
+/**
+ * @struct Board_Lines
+ * @brief Fixed-capacity list of line bitmasks with their directions
+ * @tparam CAPACITY Maximum number of lines
+ */
+template <size_t CAPACITY>
+struct Board_Lines {
+    array<uint64_t, CAPACITY> masks{};     ///< Cells of each line as a bitmask
+    array<uint8_t, CAPACITY> directions{}; ///< Index into LINE_DIRECTIONS of each line
+    int count = 0;                         ///< Number of lines stored
+
+    /** @brief Bitmask of the i-th line */
+    constexpr uint64_t operator[](int i) const { return masks[i]; }
+};
+
+/**
+ * @class Board_Geometry
+ * @brief Maps the playable cells of a shaped ROWS x COLS board to dense indices
+ * @tparam ROWS Rows of the enclosing rectangle
+ * @tparam COLS Columns of the enclosing rectangle
+ */
+template <int ROWS, int COLS>
+class Board_Geometry {
+public:
+    /// Upper bound on the lines of one length: one per start cell and direction
+    static constexpr size_t MAX_LINES = size_t(ROWS) * COLS * 4;
+
+    /**
+     * @brief Build the geometry from a drawing of the board
+     * @param shape ROWS strings of COLS characters, '.' for playable cells
+     */
+    constexpr explicit Board_Geometry(const char* const (&shape)[ROWS]) {
+        for (int r = 0; r < ROWS; r++) {
+            for (int c = 0; c < COLS; c++) {
+                if (shape[r][c] == '.') {
+                    cell_index[r][c] = int8_t(cells);
+                    cell_row[cells] = uint8_t(r);
+                    cell_col[cells] = uint8_t(c);
+                    cells++;
+                } else {
+                    cell_index[r][c] = -1;
+                }
+            }
+        }
+    }
+
+    /** @brief Number of playable cells */
+    constexpr int size() const { return cells; }
+
+    /** @brief Bitmask with every playable cell set */
+    constexpr uint64_t full_mask() const { return cells == 64 ? ~0ull : (1ull << cells) - 1; }
+
+    /** @brief Dense index of a cell, or -1 if it is off the board or not playable */
+    constexpr int index(int row, int col) const {
+        return (row < 0 || row >= ROWS || col < 0 || col >= COLS) ? -1 : cell_index[row][col];
+    }
+
+    /** @brief True if the cell is on the board and playable */
+    constexpr bool playable(int row, int col) const { return index(row, col) >= 0; }
+
+    /** @brief Row of a dense cell */
+    constexpr int row_of(int cell) const { return cell_row[cell]; }
+
+    /** @brief Column of a dense cell */
+    constexpr int col_of(int cell) const { return cell_col[cell]; }
+
+    /**
+     * @brief Every straight line of `length` playable cells
+     * @details Lines are listed by start cell in reading order, then by
+     *          direction in LINE_DIRECTIONS order.
+     */
+    constexpr Board_Lines<MAX_LINES> lines(int length) const {
+        Board_Lines<MAX_LINES> result;
+        for (int cell = 0; cell < cells; cell++) {
+            for (int d = 0; d < 4; d++) {
+                uint64_t mask = 0;
+                int k = 0;
+                for (; k < length; k++) {
+                    int i = index(cell_row[cell] + k * LINE_DIRECTIONS[d][0],
+                                  cell_col[cell] + k * LINE_DIRECTIONS[d][1]);
+                    if (i < 0) break;
+                    mask |= 1ull << i;
+                }
+                if (k == length) {
+                    result.masks[result.count] = mask;
+                    result.directions[result.count] = uint8_t(d);
+                    result.count++;
+                }
+            }
+        }
+        return result;
+    }
+
+private:
+    int cells = 0;                     ///< Number of playable cells
+    int8_t cell_index[ROWS][COLS]{};   ///< Dense index of each cell, -1 if not playable
+    uint8_t cell_row[64]{};            ///< Row of each dense cell
+    uint8_t cell_col[64]{};            ///< Column of each dense cell
+};
+
+#endif // BOARD_GEOMETRY_H
@@ -11,8 +11,163 @@
 #define CONNECT_4_H
 
 #include "BoardGame_Classes.h"
+#include <cstdint>
+#include <bit>
+#include <chrono>
 using namespace std;
 
+/**
+ * @struct Connect_4_Position
+ * @brief Bitboard encoding of a Connect 4 position.
+ *
+ * Every column takes HEIGHT + 1 bits (the extra bit is a sentinel that
+ * keeps shifts from wrapping between columns), bit `col * 7 + row` with
+ * row 0 at the bottom. `current` holds the stones of the player to move
+ * and `mask` all stones, so playing a move is an add and an XOR, and
+ * four-in-a-row is found with a handful of shift-and-AND steps.
+ * `current + mask` is a unique key for the position.
+ */
+struct Connect_4_Position {
+    static const int WIDTH = 7;   ///< Number of columns
+    static const int HEIGHT = 6;  ///< Number of rows
+
+    uint64_t current = 0;  ///< Stones of the player to move
+    uint64_t mask = 0;     ///< All stones on the board
+    int moves = 0;         ///< Stones played so far
+
+    /** @brief Bit of the bottom cell of a column */
+    static constexpr uint64_t bottom_mask_col(int col) { return 1ull << (col * (HEIGHT + 1)); }
+
+    /** @brief Bit of the top cell of a column */
+    static constexpr uint64_t top_mask_col(int col) { return 1ull << (HEIGHT - 1 + col * (HEIGHT + 1)); }
+
+    /** @brief All playable cells of a column */
+    static constexpr uint64_t column_mask(int col) { return ((1ull << HEIGHT) - 1) << (col * (HEIGHT + 1)); }
+
+    static constexpr uint64_t BOTTOM = 0x0000040810204081ull;          ///< Bottom cell of every column
+    static constexpr uint64_t BOARD = BOTTOM * ((1ull << HEIGHT) - 1); ///< Every playable cell
+
+    /** @brief Check if a column still has room */
+    bool can_play(int col) const { return (mask & top_mask_col(col)) == 0; }
+
+    /** @brief Drop a stone for the player to move and pass the turn */
+    void play(int col) { play_move((mask + bottom_mask_col(col)) & column_mask(col)); }
+
+    /** @brief Play a move given as the bit of its landing cell */
+    void play_move(uint64_t move) {
+        current ^= mask;
+        mask |= move;
+        moves++;
+    }
+
+    /** @brief Unique key of the position */
+    uint64_t key() const { return current + mask; }
+
+    /**
+     * @brief Reverse the column order of a bitboard or key
+     * @details Each column is a separate 7-bit group (keys never carry
+     *          between columns), so mirroring just swaps the groups.
+     */
+    static uint64_t mirror(uint64_t bits) {
+        uint64_t result = 0;
+        for (int col = 0; col < WIDTH; col++) {
+            uint64_t group = (bits >> (col * (HEIGHT + 1))) & ((1ull << (HEIGHT + 1)) - 1);
+            result |= group << ((WIDTH - 1 - col) * (HEIGHT + 1));
+        }
+        return result;
+    }
+
+    /** @brief Smaller of the key and its left-right mirror, shared by both mirror images */
+    uint64_t canonical_key() const {
+        uint64_t k = key();
+        uint64_t m = mirror(k);
+        return k < m ? k : m;
+    }
+
+    /** @brief The position reflected left to right */
+    Connect_4_Position mirrored() const {
+        Connect_4_Position result = *this;
+        result.current = mirror(current);
+        result.mask = mirror(mask);
+        return result;
+    }
+
+    /** @brief Landing cell of every column that is not full */
+    uint64_t possible() const { return (mask + BOTTOM) & BOARD; }
+
+    /** @brief Check if dropping in col wins for the player to move */
+    bool is_winning_move(int col) const {
+        return (winning_positions() & possible() & column_mask(col)) != 0;
+    }
+
+    /** @brief Check if the player to move can win immediately */
+    bool can_win_next() const { return (winning_positions() & possible()) != 0; }
+
+    /** @brief Empty cells that would complete four for the player to move */
+    uint64_t winning_positions() const { return compute_winning_position(current, mask); }
+
+    /** @brief Empty cells that would complete four for the opponent */
+    uint64_t opponent_winning_positions() const { return compute_winning_position(current ^ mask, mask); }
+
+    /**
+     * @brief Moves that do not hand the opponent an immediate win
+     * @return Landing bits; 0 if every move loses. Assumes the player to
+     *         move cannot win immediately.
+     */
+    uint64_t possible_non_losing_moves() const {
+        uint64_t possible_mask = possible();
+        uint64_t opponent_win = opponent_winning_positions();
+        uint64_t forced = possible_mask & opponent_win;
+        if (forced) {
+            if (forced & (forced - 1))
+                return 0;  // two threats at once cannot both be blocked
+            possible_mask = forced;
+        }
+        return possible_mask & ~(opponent_win >> 1);  // never play right below an opponent threat
+    }
+
+    /** @brief Number of winning cells the player to move gains by playing move */
+    int move_score(uint64_t move) const {
+        return popcount(compute_winning_position(current | move, mask));
+    }
+
+    /** @brief Check if a set of stones contains four in a row */
+    static bool has_four(uint64_t stones) {
+        uint64_t m = stones & (stones >> (HEIGHT + 1));  // horizontal
+        if (m & (m >> (2 * (HEIGHT + 1)))) return true;
+        m = stones & (stones >> HEIGHT);                 // diagonal /
+        if (m & (m >> (2 * HEIGHT))) return true;
+        m = stones & (stones >> (HEIGHT + 2));           // diagonal backslash
+        if (m & (m >> (2 * (HEIGHT + 2)))) return true;
+        m = stones & (stones >> 1);                      // vertical
+        if (m & (m >> 2)) return true;
+        return false;
+    }
+
+    /**
+     * @brief Empty cells that would give a set of stones four in a row
+     * @param stones Stones of one player
+     * @param mask All stones on the board
+     */
+    static uint64_t compute_winning_position(uint64_t stones, uint64_t mask) {
+        // vertical
+        uint64_t r = (stones << 1) & (stones << 2) & (stones << 3);
+
+        // horizontal and both diagonals: shift by the step of each direction
+        const int steps[3] = { HEIGHT + 1, HEIGHT, HEIGHT + 2 };
+        for (int step : steps) {
+            uint64_t p = (stones << step) & (stones << (2 * step));
+            r |= p & (stones << (3 * step));
+            r |= p & (stones >> step);
+            p = (stones >> step) & (stones >> (2 * step));
+            r |= p & (stones << step);
+            r |= p & (stones >> (3 * step));
+        }
+
+        return r & (BOARD ^ mask);
+    }
+};
+
 /**
  * @class Connect_4
  * @brief Represents the Connect 4 game board.
@@ -26,6 +181,8 @@ using namespace std;
 class Connect_4 : public Board<char> {
 private:
     char blank_symbol = '.'; ///< Character used to represent an empty cell on the board.
+    Connect_4_Position position; ///< Bitboard copy of the board used for win checks and search.
+    char first_symbol = 0;       ///< Symbol of the player who moved first.
 
 public:
     int a = 0; ///< Row position of the last placed token.
@@ -83,6 +240,289 @@ public:
      * @return true if the game has ended, false otherwise.
      */
     bool game_is_over(Player<char>* player) override;
+
+    /**
+     * @brief Returns the bitboard form of the current position.
+     *
+     * @return Reference to the position, with the player to move as `current`.
+     */
+    const Connect_4_Position& get_position() const { return position; }
+};
+
+/**
+ * @class Connect_4_Book
+ * @brief Read-only opening book mapped into memory.
+ *
+ * The book is produced offline by `connect_4_book_gen` and holds the exact
+ * score of every position up to a fixed number of moves, keyed by
+ * `Connect_4_Position::canonical_key()` so mirror images share one entry.
+ *
+ * File layout (little-endian): a 24-byte header (magic "C4BK", version,
+ * depth, reserved word, entry count), then `count` sorted uint64 keys,
+ * then `count` int8 scores. The file is mapped, not parsed, so opening it
+ * is instant and lookups are a binary search over the mapped keys.
+ */
+class Connect_4_Book {
+public:
+    static const uint32_t VERSION = 1; ///< File format version
+
+    /** @brief Header at the start of a book file. */
+    struct Header {
+        char magic[4];     ///< "C4BK"
+        uint32_t version;  ///< File format version
+        uint32_t depth;    ///< Deepest position stored, in moves played
+        uint32_t reserved; ///< Zero
+        uint64_t count;    ///< Number of entries
+    };
+
+    Connect_4_Book() = default;
+    ~Connect_4_Book();
+    Connect_4_Book(const Connect_4_Book&) = delete;
+    Connect_4_Book& operator=(const Connect_4_Book&) = delete;
+
+    /**
+     * @brief Maps a book file into memory.
+     *
+     * @param path Path of the book file.
+     * @return true if the file was mapped and its header is valid.
+     */
+    bool open(const string& path);
+
+    /** @brief Unmaps the book. */
+    void close();
+
+    /** @brief True if a book is mapped. */
+    bool is_open() const { return keys != nullptr; }
+
+    /** @brief Deepest position stored, in moves played. */
+    int get_depth() const { return depth; }
+
+    /** @brief Number of positions stored. */
+    size_t size() const { return count; }
+
+    /**
+     * @brief Looks up the score of a position.
+     *
+     * @param pos Position to look up.
+     * @param score Receives the score for the player to move.
+     * @return true if the position is in the book.
+     */
+    bool probe(const Connect_4_Position& pos, int& score) const;
+
+private:
+    void* data = nullptr;           ///< Start of the mapping
+    size_t length = 0;              ///< Length of the mapping in bytes
+    const uint64_t* keys = nullptr; ///< Sorted keys inside the mapping
+    const int8_t* scores = nullptr; ///< Scores inside the mapping
+    size_t count = 0;               ///< Number of entries
+    int depth = 0;                  ///< Deepest position stored
+#ifdef _WIN32
+    void* file_handle = nullptr;    ///< Windows file handle
+    void* mapping_handle = nullptr; ///< Windows file mapping handle
+#endif
+};
+
+/**
+ * @class Connect_4_Solver
+ * @brief Perfect-play solver for Connect 4 positions.
+ *
+ * Negamax with alpha-beta pruning over `Connect_4_Position`, using a
+ * transposition table of bounds, center-first move ordering refined by
+ * the number of threats each move creates, pruning of moves that hand the
+ * opponent a win, and a null-window bisection on the score.
+ *
+ * Scores are from the side to move: positive wins (higher means fewer
+ * stones needed), 0 draws, negative losses. If an opening book is
+ * attached, best_move() answers from it whenever every reply is in the
+ * book and searches only past its depth. A search that
+ * runs past the time limit is abandoned and the best move falls back to a
+ * threat-count heuristic among non-losing moves.
+ */
+class Connect_4_Solver {
+public:
+    static const int MIN_SCORE = -(Connect_4_Position::WIDTH * Connect_4_Position::HEIGHT) / 2 + 3; ///< Lowest possible score
+    static const int MAX_SCORE = (Connect_4_Position::WIDTH * Connect_4_Position::HEIGHT + 1) / 2 - 3; ///< Highest possible score
+
+    /**
+     * @brief Constructs a solver.
+     *
+     * @param time_limit_ms Time budget per best_move() call in milliseconds (0 for no limit).
+     */
+    explicit Connect_4_Solver(int time_limit_ms = 3000);
+
+    /**
+     * @brief Computes the exact score of a position.
+     *
+     * @param pos Position to solve; must not be won already.
+     * @param weak If true, only the sign of the score is computed (win/draw/loss).
+     * @return Score for the player to move; meaningless if timed_out() is set.
+     */
+    int solve(const Connect_4_Position& pos, bool weak = false);
+
+    /**
+     * @brief Chooses the best column for the player to move.
+     *
+     * @param pos Position to play from; must have a legal move.
+     * @param score Receives the score of the chosen move.
+     * @return Column index, center-most among equal scores.
+     */
+    int best_move(const Connect_4_Position& pos, int& score);
+
+    /** @brief True if the last best_move() ran out of time and used the heuristic. */
+    bool timed_out() const { return aborted; }
+
+    /** @brief True if the last best_move() was answered from the opening book. */
+    bool used_book() const { return from_book; }
+
+    /**
+     * @brief Attaches an opening book consulted by best_move().
+     *
+     * @param opening_book Mapped book, or nullptr to detach; must outlive the solver's use of it.
+     */
+    void set_book(const Connect_4_Book* opening_book) { book = opening_book; }
+
+    /** @brief Number of positions searched by the last best_move(). */
+    long long get_node_count() const { return nodes; }
+
+    /** @brief Sets the time budget per best_move() call (0 for no limit). */
+    void set_time_limit(int ms) { time_limit_ms = ms; }
+
+    /** @brief Column order used for ties: center first. */
+    static int column_order(int i) {
+        return Connect_4_Position::WIDTH / 2 + (1 - 2 * (i % 2)) * (i + 1) / 2;
+    }
+
+private:
+    static const int TABLE_SIZE = 8388593; ///< Prime number of table slots (about 8M).
+
+    vector<uint32_t> table_keys;  ///< Low 32 bits of the key stored in each slot
+    vector<uint8_t> table_values; ///< Encoded bound for each slot, 0 if empty
+    int time_limit_ms;            ///< Time budget per best_move() call
+    long long nodes = 0;          ///< Positions searched
+    bool aborted = false;         ///< Set when the time budget ran out
+    bool from_book = false;       ///< Set when the last move came from the book
+    const Connect_4_Book* book = nullptr; ///< Optional opening book
+    chrono::steady_clock::time_point deadline; ///< End of the time budget
+
+    /** @brief Looks up the encoded bound of a position, 0 if absent. */
+    uint8_t table_get(uint64_t key) const;
+
+    /** @brief Stores the encoded bound of a position. */
+    void table_put(uint64_t key, uint8_t value);
+
+    /**
+     * @brief Alpha-beta negamax with a transposition table.
+     *
+     * @param pos Position where the player to move cannot win immediately.
+     * @param alpha Lower bound of the search window.
+     * @param beta Upper bound of the search window.
+     * @return Exact score if inside (alpha, beta), otherwise a bound.
+     */
+    int negamax(const Connect_4_Position& pos, int alpha, int beta);
+
+    /**
+     * @brief Picks a non-losing move by threat count when the search times out.
+     *
+     * @param pos Position to play from.
+     * @return Column index.
+     */
+    int heuristic_move(const Connect_4_Position& pos) const;
+
+    /**
+     * @brief Picks the best move from the opening book.
+     *
+     * @param pos Position where the player to move cannot win immediately.
+     * @param score Receives the score of the chosen move.
+     * @return Column index, or -1 if some reply is missing from the book.
+     */
+    int book_move(const Connect_4_Position& pos, int& score) const;
+};
+
+/**
+ * @struct Connect_4_Playout_Stats
+ * @brief Random-playout results per root move, counted for the player at the root.
+ */
+struct Connect_4_Playout_Stats {
+    uint64_t wins[Connect_4_Position::WIDTH] = {};   ///< Playouts the root player won
+    uint64_t draws[Connect_4_Position::WIDTH] = {};  ///< Playouts that filled the board
+    uint64_t losses[Connect_4_Position::WIDTH] = {}; ///< Playouts the root player lost
+
+    /** @brief Number of playouts after a root move */
+    uint64_t playouts(int col) const { return wins[col] + draws[col] + losses[col]; }
+
+    /** @brief Expected result of a root move, counting a draw as half a win */
+    double win_rate(int col) const {
+        uint64_t n = playouts(col);
+        return n ? (wins[col] + 0.5 * draws[col]) / n : 0.0;
+    }
+};
+
+/**
+ * @class Connect_4_Playout_Kernel
+ * @brief Plays uniformly random games to the end, many at a time.
+ *
+ * The AVX2 backend keeps LANES games in vector registers and advances
+ * them in lockstep: each step picks a random column for every lane
+ * (retrying only the lanes whose column is full), plays it, and tests
+ * four-in-a-row with the same shift-and-AND steps as
+ * Connect_4_Position::has_four. A finished lane is refilled with a new
+ * game until the batch is used up. The scalar backend plays the games one
+ * after another with the same random-move rule. The best backend the CPU
+ * supports is chosen at run time, so the binary needs no -mavx2 flag;
+ * compilers other than GCC and Clang on x86 get the scalar backend only.
+ */
+class Connect_4_Playout_Kernel {
+public:
+    /** @brief Implementation used for the playouts */
+    enum class Backend { SCALAR, AVX2 };
+
+    static const int LANES = 8; ///< Games advanced together, and random generators kept
+
+    /**
+     * @brief Creates a kernel.
+     *
+     * @param seed Seed for the per-lane random generators.
+     * @param backend Implementation to use; falls back to SCALAR if the CPU lacks it.
+     */
+    explicit Connect_4_Playout_Kernel(uint64_t seed = 0x9E3779B97F4A7C15ull,
+                                      Backend backend = best_backend());
+
+    /** @brief Fastest backend supported by this CPU and build. */
+    static Backend best_backend();
+
+    /** @brief Human-readable backend name. */
+    static const char* backend_name(Backend backend);
+
+    /** @brief Backend this kernel runs. */
+    Backend get_backend() const { return backend; }
+
+    /**
+     * @brief Plays random games from a position.
+     *
+     * @param start Position to play from; must not be over already.
+     * @param count Number of games.
+     * @param wins Incremented by the games won by the player to move at `start`.
+     * @param draws Incremented by the drawn games.
+     * @param losses Incremented by the games lost by the player to move at `start`.
+     */
+    void run(const Connect_4_Position& start, uint64_t count,
+             uint64_t& wins, uint64_t& draws, uint64_t& losses);
+
+    /**
+     * @brief Plays random games after every legal move of a position.
+     *
+     * A move that wins at once is counted as `playouts_per_move` wins
+     * without playing anything out.
+     *
+     * @param root Position whose moves are evaluated.
+     * @param playouts_per_move Games played after each move.
+     * @return Results per column, from the view of the player to move at `root`.
+     */
+    Connect_4_Playout_Stats evaluate_moves(const Connect_4_Position& root, uint64_t playouts_per_move);
+
+private:
+    Backend backend;      ///< Implementation in use
+    uint64_t rng[LANES];  ///< xorshift64 state of each lane
 };
 
 /**
@@ -121,8 +561,8 @@ public:
     /**
      * @brief Retrieves the next move from a player.
      *
-     * For human players, prompts for column input. For computer players,
-     * generates a random valid column.
+     * For human players, prompts for column input. Random computer players
+     * pick a uniformly random non-full column, and AI players ask the solver.
      *
      * @param player Pointer to the player whose move is being requested.
      * @return A pointer to a new `Move<char>` object representing the player's action.
@@ -130,4 +570,36 @@ public:
     Move<char>* get_move(Player<char>* player) override;
 };
 
+/**
+ * @class Connect_4_AI_Player
+ * @brief Computer player that plays perfectly using `Connect_4_Solver`.
+ */
+class Connect_4_AI_Player : public Player<char> {
+private:
+    Connect_4_Book book;     ///< Opening book, mapped from connect_4_book.bin if present.
+    Connect_4_Solver solver; ///< Solver reused across moves so its table stays warm.
+
+public:
+    /**
+     * @brief Constructs a solver-driven player.
+     *
+     * Maps connect_4_book.bin from the current or parent directory if it exists.
+     *
+     * @param name Name of the player.
+     * @param symbol Character symbol ('X' or 'O').
+     */
+    Connect_4_AI_Player(string name, char symbol);
+
+    /**
+     * @brief Chooses a column for the current board.
+     *
+     * @param score Receives the solver's score of the move.
+     * @return Column index.
+     */
+    int choose_column(int& score);
+
+    /** @brief Returns the solver, e.g. to read its statistics. */
+    const Connect_4_Solver& get_solver() const { return solver; }
+};
+
 #endif // CONNECT_4_H
\ No newline at end of file
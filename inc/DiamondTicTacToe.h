@@ -3,92 +3,114 @@
  * @brief Diamond Tic-Tac-Toe game with Minimax AI
  * @details This file contains the declarations for a Diamond-shaped Tic-Tac-Toe game
  *          where players must form both a 3-line and 4-line in different directions to win.
- *          The AI uses Minimax algorithm with Alpha-Beta pruning for optimal play.
+ *          The AI searches with the shared alpha-beta engine in Game_Search.h.
  */
 
 #ifndef _DIAMOND_TICTACTOE_H
 #define _DIAMOND_TICTACTOE_H
 
 #include "BoardGame_Classes.h"
+#include "Board_Geometry.h"
+#include "Game_Random.h"
+#include "Game_Search.h"
 #include <vector>
 #include <utility>
 
 using namespace std;
 
+/**
+ * @struct Diamond_Position
+ * @brief Diamond position for Search: a bitboard of each side's marks over the 25 dense cells
+ * @details A move is the dense index of the cell to mark.
+ */
+struct Diamond_Position {
+    using Move = uint8_t;
+    static const int MAX_MOVES = 25;  ///< Playable cells
+    static const int MOVE_SPACE = 25; ///< Move values are dense cell indices
+
+    uint64_t stones[2] = { 0, 0 }; ///< X's and O's marks
+    int side = 0;                  ///< Side to move: 0 for X, 1 for O
+    int n_moves = 0;               ///< Marks on the board
+
+    /**
+     * @brief Check a bitboard for the winning pattern
+     * @param own Marks of one side
+     * @return True if they hold a full 3-line and a full 4-line in different directions
+     */
+    static bool wins(uint64_t own);
+
+    /** @brief Empty cells for the side to move, center first; returns the count */
+    int generate_moves(Move* moves) const;
+
+    void make(Move cell) { stones[side] |= 1ull << cell; side ^= 1; n_moves++; }
+    void unmake(Move cell) { n_moves--; side ^= 1; stones[side] &= ~(1ull << cell); }
+
+    /** @brief Open 3- and 4-lines of the side to move minus the opponent's, weighted by marks */
+    int evaluate() const;
+
+    /** @brief Mixed key of both bitboards and the side to move */
+    uint64_t hash() const {
+        uint64_t key = stones[0] | stones[1] << 25 | uint64_t(side) << 50;
+        return Game_Random::splitmix64(key);
+    }
+
+    /** @brief Over once the last mover has won or the board is full */
+    bool is_terminal(int& result) const {
+        result = wins(stones[side ^ 1]) ? -1 : 0;
+        return result != 0 || n_moves >= MAX_MOVES;
+    }
+};
+
 /**
  * @class DiamondBoard
  * @brief Board class for Diamond Tic-Tac-Toe game
- * @details Manages a 7x7 grid with a diamond-shaped playing area (37 cells).
- *          Implements win detection for simultaneous 3-line and 4-line formations
- *          in different directions. Includes Minimax AI with Alpha-Beta pruning.
+ * @details Manages a 7x7 grid with a diamond-shaped playing area (25 cells).
+ *          The playable cells are numbered densely by Board_Geometry, so each
+ *          player's marks form a 25-bit bitboard and win detection tests the
+ *          precomputed 3- and 4-cell lines as masks. The AI searches a
+ *          Diamond_Position with Search.
  */
 class DiamondBoard : public Board<char> {
 private:
     char blank = '.';
-    
-    /**
-     * @brief Initialize the diamond shape pattern on the 7x7 grid
-     * @details Creates a diamond with 1, 3, 5, 7, 5, 3, 1 cells per row
-     */
-    void initialize_diamond_shape();
-    
+    uint64_t stones[2] = { 0, 0 }; ///< Bitboards of X's and O's marks over the dense cells
+
     /**
-     * @brief Find all lines of specific length for a symbol
+     * @brief Bitboard index of a symbol
      * @param symbol The player's symbol ('X' or 'O')
-     * @param length The length of lines to find (3 or 4)
-     * @return Vector of all valid lines found
-     */
-    vector<vector<pair<int,int>>> find_lines_of_length(char symbol, int length);
-    
-    /**
-     * @brief Check if two lines are in different directions
-     * @param line1 First line to compare
-     * @param line2 Second line to compare
-     * @return True if lines have different direction vectors
+     * @return 0 for 'X', 1 otherwise
      */
-    bool lines_different_directions(const vector<pair<int,int>>& line1,
-                                    const vector<pair<int,int>>& line2);
-    
+    static int side_of(char symbol) { return symbol == 'X' ? 0 : 1; }
+
     /**
-     * @brief Count shared cells between two lines
-     * @param line1 First line
-     * @param line2 Second line
-     * @return Number of cells that appear in both lines
+     * @brief Place or remove a mark on a dense cell, keeping the bitboards in sync
+     * @param cell Dense cell index
+     * @param symbol Mark to place, or blank to clear the cell
      */
-    int count_shared_cells(const vector<pair<int,int>>& line1,
-                          const vector<pair<int,int>>& line2);
+    void set_cell(int cell, char symbol);
     
     /**
      * @brief Check win condition for a specific symbol
      * @param symbol The symbol to check ('X' or 'O')
      * @return True if symbol has both 3-line and 4-line in different directions
-     * @details Win requires lines sharing 0 or 1 cell maximum
+     * @details Lines in different directions share at most one cell, so the
+     *          0-or-1 shared cell rule always holds
      */
     bool check_win_for_symbol(char symbol);
-    
-    /**
-     * @brief Minimax algorithm with Alpha-Beta Pruning
-     * @param current_player Symbol of player making the current move
-     * @param ai_symbol Symbol of the AI player
-     * @param depth Current depth in the search tree
-     * @param max_depth Maximum depth to search
-     * @param alpha Best score the maximizer can guarantee
-     * @param beta Best score the minimizer can guarantee
-     * @return Evaluation score for the current position
-     */
-    int minimax(char current_player, char ai_symbol, int depth, int max_depth, int alpha, int beta);
 
 public:
     /**
-     * @brief 2D array marking valid cells in the diamond shape
-     * @details True indicates cell is part of the playable diamond area
+     * @brief Constructor - initializes 7x7 board with diamond shape
      */
-    bool diamond_shape[7][7];
+    DiamondBoard();
 
     /**
-     * @brief Constructor - initializes 7x7 board with diamond shape
+     * @brief Check if a cell is part of the playable diamond area
+     * @param x Row index
+     * @param y Column index
+     * @return True if the cell is on the 7x7 grid and inside the diamond
      */
-    DiamondBoard();
+    bool is_playable(int x, int y) const;
     
     /**
      * @brief Update board with a move
@@ -115,7 +137,7 @@ public:
     /**
      * @brief Check if game is a draw
      * @param player Pointer to player (unused)
-     * @return True if all 37 diamond cells are filled
+     * @return True if all 25 diamond cells are filled
      */
     bool is_draw(Player<char>* player) override;
     
@@ -127,11 +149,12 @@ public:
     bool game_is_over(Player<char>* player) override;
     
     /**
-     * @brief Get best move using Minimax algorithm
+     * @brief Get best move from an alpha-beta search
      * @param ai_symbol Symbol of the AI player ('X' or 'O')
-     * @param difficulty Search depth (higher = smarter but slower)
+     * @param difficulty Plies searched after the AI's move (higher = smarter but slower)
      * @return Pair of (row, col) coordinates for best move
-     * @details Uses Alpha-Beta pruning for efficiency. Default difficulty is 3.
+     * @details Iterative deepening up to difficulty + 1 plies within a
+     *          3 second budget. Default difficulty is 3.
      */
     pair<int, int> get_best_move(char ai_symbol, int difficulty = 3);
 };
@@ -139,7 +162,7 @@ public:
 /**
  * @class DiamondPlayer
  * @brief Player class for Diamond Tic-Tac-Toe
- * @details Handles both human and computer players. Computer uses Minimax AI.
+ * @details Handles both human and computer players. Computer uses an alpha-beta search.
  */
 class DiamondPlayer : public Player<char> {
 public:
@@ -154,7 +177,7 @@ public:
     /**
      * @brief Get move from player
      * @return Pointer to Move object with chosen position
-     * @details Computer players use Minimax AI at difficulty level 7
+     * @details Computer players search at difficulty level 7
      */
     Move<char>* get_move();
 };
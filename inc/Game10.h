@@ -7,17 +7,229 @@
 #define GAME10_H
 
 #include "BoardGame_Classes.h"
+#include "Game_Random.h"
+#include "MNK_Board.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
 #include <vector>
 
+/**
+ * @brief Compact 6x6 position for search: a bitmask per player plus obstacles
+ *
+ * Cell (x, y) is bit x * 6 + y. X is side 0 and moves when moves() is even;
+ * two obstacles drop as blocked cells after every second move.
+ */
+using Game10_Position = MNKBoard<6, 6, 4>;
+
+/**
+ * @class Game10_Expectimax
+ * @brief Depth-limited expectimax player for Obstacles Tic-Tac-Toe
+ *
+ * Player moves are searched by alpha-beta negamax. After every second move
+ * a chance node averages over the obstacle drop, which picks two distinct
+ * empty cells uniformly: every pair is expanded when there are at most
+ * EXACT_PAIRS of them, otherwise SAMPLED_PAIRS pairs are drawn. Chance
+ * nodes are pruned with Star1, using the score bounds to cut off the
+ * remaining outcomes once the average can no longer enter the window.
+ * Leaves are scored by the open 4-cell windows of each side. The search
+ * deepens iteratively until the time budget runs out and plays the best
+ * move of the last completed depth. It stops early on a won or lost root
+ * score only when every chance node of that iteration was expanded in
+ * full, since a sampled average is not a proof.
+ *
+ * Scores are from the side to move: WIN_SCORE minus the plies to a win,
+ * the negative for a loss, and heuristic values far inside those bounds.
+ */
+class Game10_Expectimax {
+public:
+    static const int WIN_SCORE = 1000000; ///< Score of an immediate win
+    static const int EXACT_PAIRS = 15;    ///< Expand every obstacle pair up to this many (6 empty cells)
+    static const int SAMPLED_PAIRS = 6;   ///< Obstacle pairs drawn at wider chance nodes
+
+    /**
+     * @brief Creates an engine
+     * @param time_limit_ms Time budget per best_move() call in milliseconds (0 for no limit)
+     * @param max_depth Deepest iteration in player moves (0 to search until the board is full)
+     */
+    explicit Game10_Expectimax(int time_limit_ms = 1000, int max_depth = 0)
+        : time_limit_ms(time_limit_ms), max_depth(max_depth) {}
+
+    /**
+     * @brief Chooses a move for the side to move
+     * @param pos Position with at least one empty cell and no winner
+     * @param score Receives the expected score of the chosen move
+     * @return Cell index of the move, or -1 if the board is full
+     */
+    int best_move(const Game10_Position& pos, double& score);
+
+    /** @brief Deepest completed iteration of the last best_move() */
+    int get_depth() const { return completed_depth; }
+
+    /** @brief Nodes visited by the last best_move() */
+    long long get_node_count() const { return nodes; }
+
+    /** @brief Sets the time budget per best_move() call (0 for no limit) */
+    void set_time_limit(int ms) { time_limit_ms = ms; }
+
+private:
+    int time_limit_ms;            ///< Time budget per best_move() call
+    int max_depth;                ///< Iteration limit, 0 for none
+    int completed_depth = 0;      ///< Deepest completed iteration
+    long long nodes = 0;          ///< Nodes visited
+    bool aborted = false;         ///< Set when the time budget ran out
+    bool exact = true;            ///< False once a chance node of the current iteration sampled its outcomes
+    Game_Random rng;              ///< Generator for sampling obstacle pairs, reseeded per search
+    chrono::steady_clock::time_point deadline; ///< End of the time budget
+
+    /**
+     * @brief Alpha-beta negamax over the side to move's choices
+     * @param pos Position with no winner yet
+     * @param depth Player moves left to search
+     * @param alpha Lower bound of the window
+     * @param beta Upper bound of the window
+     * @param ply Moves made since the root
+     * @return Score if inside (alpha, beta), otherwise a bound
+     */
+    double search(const Game10_Position& pos, int depth, double alpha, double beta, int ply);
+
+    /**
+     * @brief Expected score over the obstacle drop, with Star1 pruning
+     * @param pos Position right after the second move of a round
+     * @return Expected score if inside (alpha, beta), otherwise a bound
+     */
+    double chance(const Game10_Position& pos, int depth, double alpha, double beta, int ply);
+
+    /** @brief Heuristic score of a quiet position for the side to move */
+    double evaluate(const Game10_Position& pos) const;
+
+    /** @brief Counts a node and checks the clock every few thousand nodes */
+    bool out_of_time();
+};
+
+/**
+ * @brief Budget for the Game10 Monte Carlo player
+ */
+struct Game10_Monte_Carlo_Config {
+    int time_limit_ms = 500;        ///< Stop after this many milliseconds (0 = no limit)
+    int playouts_per_move = 20000;  ///< Stop once every candidate move has this many playouts
+    int threads = 1;                ///< Number of playout threads
+};
+
+/**
+ * @class Game10_Monte_Carlo
+ * @brief Flat Monte Carlo player for Obstacles Tic-Tac-Toe
+ *
+ * Every legal move is scored by uniformly random playouts to the end of
+ * the game, with the obstacle drops sampled as in play, and the move with
+ * the best mean result (win 1, draw 1/2) is chosen. An immediate win is
+ * played without playouts.
+ *
+ * Each thread cycles through the candidate moves, starting at a different
+ * one, and keeps its own generator, position scratch and counters. The
+ * helper threads are started by the first search and then wait on a
+ * condition variable until the next search releases them, so a move pays
+ * no thread creation inside its time budget. The counters are summed once
+ * every helper has reported back, so the playouts share no state.
+ */
+class Game10_Monte_Carlo {
+public:
+    /**
+     * @brief Creates a player
+     * @param config Time and playout budget
+     * @param seed Seed for the per-thread generators
+     */
+    explicit Game10_Monte_Carlo(const Game10_Monte_Carlo_Config& config = Game10_Monte_Carlo_Config(),
+                                uint64_t seed = 0x9E3779B97F4A7C15ull)
+        : config(config), seed(seed) {}
+
+    /** @brief Stops and joins the helper threads */
+    ~Game10_Monte_Carlo();
+
+    Game10_Monte_Carlo(const Game10_Monte_Carlo&) = delete;
+    Game10_Monte_Carlo& operator=(const Game10_Monte_Carlo&) = delete;
+
+    /**
+     * @brief Chooses a move for the side to move
+     * @param pos Position with at least one empty cell and no winner
+     * @param win_rate Receives the mean result of the chosen move
+     * @return Cell index of the move, or -1 if the board is full
+     */
+    int best_move(const Game10_Position& pos, double& win_rate);
+
+    /** @brief Playouts run by the last best_move(), all threads together */
+    long long get_playout_count() const { return playouts; }
+
+    /**
+     * @brief Plays uniformly random moves and obstacle drops to the end of the game
+     * @param pos Position to play out, modified in place
+     * @param rng Generator for moves and obstacles
+     * @return 0 if X wins, 1 if O wins, -1 for a draw
+     */
+    static int playout(Game10_Position& pos, Game_Random& rng);
+
+private:
+    /**
+     * @brief Per-thread state, kept across searches
+     */
+    struct Worker {
+        Game_Random rng;          ///< Generator of this thread
+        Game10_Position scratch;  ///< Position being played out
+        uint32_t plays[36];       ///< Playouts per candidate cell
+        uint32_t points[36];      ///< Results per candidate cell, 2 per win and 1 per draw
+    };
+
+    Game10_Monte_Carlo_Config config; ///< Budget
+    uint64_t seed;                    ///< Seed mixed into every worker's generator
+    uint64_t searches = 0;            ///< Searches run, so each one draws fresh playouts
+    long long playouts = 0;           ///< Playouts run by the last search
+    vector<Worker> workers;           ///< One per thread
+
+    vector<thread> helpers;           ///< Threads 1..threads-1, started by the first search
+    mutex pool_mutex;                 ///< Guards the job fields and counters below
+    condition_variable job_ready;     ///< Signalled when a search releases the helpers
+    condition_variable job_done;      ///< Signalled when the last helper finishes
+    uint64_t generation = 0;          ///< Searches released so far; a helper runs each new one once
+    int running = 0;                  ///< Helpers still working on the current search
+    bool stopping = false;            ///< Set by the destructor to end the helpers
+    const Game10_Position* job_root = nullptr; ///< Position of the current search
+    const vector<int>* job_moves = nullptr;    ///< Candidate cells of the current search
+    chrono::steady_clock::time_point job_deadline; ///< End of the current search's budget
+
+    /**
+     * @brief Body of a helper thread: waits for each search and runs its worker on it
+     * @param index Worker index, 1..threads-1
+     */
+    void helper_loop(int index);
+
+    /**
+     * @brief Runs playouts for the candidate moves until the budget is spent
+     * @param worker State of the calling thread
+     * @param root Position before the move
+     * @param moves Candidate cells
+     * @param first Index of the candidate to start with
+     * @param deadline End of the time budget
+     */
+    void run_worker(Worker& worker, const Game10_Position& root, const vector<int>& moves,
+                    int first, chrono::steady_clock::time_point deadline);
+};
+
 /**
  * @class Game10_Board
  * @brief Game board that adds obstacles after each round
+ *
+ * The marks and obstacles are kept as 36-bit masks in a Game10_Position,
+ * so win, draw and empty-cell checks take a few bit operations. The char
+ * matrix mirrors them for display.
  */
 class Game10_Board : public Board<char> {
 private:
     char blank = '.';        ///< Empty cell symbol
     char obstacle = '#';     ///< Obstacle symbol
     int round_count = 0;     ///< Round counter
+    Game10_Position position; ///< Bitboards of both players' marks and the obstacles
 
 public:
     /**
@@ -59,9 +271,15 @@ public:
      */
     bool game_is_over(Player<char>* player) override;
 
+    /**
+     * @brief Gets the bitboard position
+     * @return Marks, obstacles and move count of the board
+     */
+    const Game10_Position& get_position() const { return position; }
+
 private:
     /**
-     * @brief Adds 2 random obstacles to the board
+     * @brief Adds 2 obstacles on uniformly random empty cells
      */
     void add_obstacles();
 
@@ -74,18 +292,23 @@ private:
 
 /**
  * @class Game10_Player
- * @brief Player with random move generation
+ * @brief Player with random, expectimax or Monte Carlo move generation
  */
 class Game10_Player : public Player<char> {
 public:
+    /**
+     * @brief Engine used by a PlayerType::AI player
+     */
+    enum class Engine { EXPECTIMAX, MONTE_CARLO };
+
     /**
      * @brief Creates a player
      * @param n Name
      * @param s Symbol
      * @param t Player type
+     * @param e Engine used if t is PlayerType::AI
      */
-    Game10_Player(string n, char s, PlayerType t)
-        : Player<char>(n, s, t) {}
+    Game10_Player(string n, char s, PlayerType t, Engine e = Engine::EXPECTIMAX);
 
     /**
      * @brief Generates a random valid move
@@ -93,7 +316,29 @@ public:
      */
     Move<char>* get_random_move();
 
+    /**
+     * @brief Chooses a move with the expectimax engine
+     * @return Best move found within the time budget, or nullptr if the board is full
+     */
+    Move<char>* get_expectimax_move();
+
+    /**
+     * @brief Chooses a move by parallel random playouts
+     * @return Move with the best mean playout result, or nullptr if the board is full
+     */
+    Move<char>* get_monte_carlo_move();
+
+    /**
+     * @brief Chooses a move with this player's engine
+     * @return Chosen move, or nullptr if the board is full
+     */
+    Move<char>* get_ai_move();
+
 private:
+    Engine engine_type;             ///< Engine used by get_ai_move()
+    Game10_Expectimax engine;       ///< Expectimax search engine
+    Game10_Monte_Carlo monte_carlo; ///< Monte Carlo engine
+
     /**
      * @brief Gets all valid moves
      * @return Vector of valid moves
@@ -121,6 +366,12 @@ public:
      */
     Player<char>* create_player(string& name, char symbol, PlayerType type) override;
 
+    /**
+     * @brief Sets up both players, offering human, random, expectimax and Monte Carlo players
+     * @return Array of two player pointers
+     */
+    Player<char>** setup_players() override;
+
     /**
      * @brief Gets move from player
      * @param player The player
@@ -3,15 +3,18 @@
  * @brief 4x4 Tic-Tac-Toe with moving tokens and Minimax AI
  * @details This file contains declarations for a variant of Tic-Tac-Toe where players
  *          move their tokens on a 4x4 board. Players start with alternating tokens
- *          at opposite ends and must form a line of 3 to win. The AI uses Minimax
- *          algorithm with Alpha-Beta pruning for strategic play.
+ *          at opposite ends and must form a line of 3 to win. The AI searches with
+ *          the shared alpha-beta engine in Game_Search.h.
  */
 
 #ifndef GAME7_H
 #define GAME7_H
 
 #include "BoardGame_Classes.h"
+#include "Game_Random.h"
+#include "Game_Search.h"
 #include <vector>
+#include <cstdint>
 
 /**
  * @class Game7_Move
@@ -47,38 +50,98 @@ public:
     int get_from_y() const { return from_y; }
 };
 
+/**
+ * @struct Game7_MoveList
+ * @brief Fixed-capacity move list used by the search
+ * @details A player owns 4 tokens and each token can step in 4 directions,
+ *          so no position has more than 16 legal moves. Cells are stored as
+ *          bit indices (row * 4 + column) and the list lives on the stack,
+ *          so generating moves never touches the heap.
+ */
+struct Game7_MoveList {
+    static const int MAX_MOVES = 16;
+    uint8_t from[MAX_MOVES]; ///< Source cell index of each move
+    uint8_t to[MAX_MOVES];   ///< Destination cell index of each move
+    int count = 0;           ///< Number of moves stored
+};
+
+/**
+ * @struct Game7_Position
+ * @brief Moving-token position for Search: a bitboard of each side's tokens
+ * @details Cells are bit indices (row * 4 + column) and a move is
+ *          from * 16 + to. Making a move toggles both bits of the mover.
+ */
+struct Game7_Position {
+    using Move = uint8_t;
+    static const int MAX_MOVES = Game7_MoveList::MAX_MOVES; ///< 4 tokens, 4 steps each
+    static const int MOVE_SPACE = 256;                      ///< Move values are from * 16 + to
+
+    uint16_t tokens[2] = { 0, 0 }; ///< X's and O's tokens
+    int side = 0;                  ///< Side to move: 0 for X, 1 for O
+
+    /**
+     * @brief Generate every legal move for one side
+     * @param own Bitboard of the moving player's tokens
+     * @param empty Bitboard of empty cells
+     * @param list Output list, filled in source-cell then up/down/left/right order
+     * @details Destinations are found by shifting the token mask one step in
+     *          each direction (with edge masks to stop row wrap-around) and
+     *          intersecting with the empty cells.
+     */
+    static void generate_moves(uint16_t own, uint16_t empty, Game7_MoveList& list);
+
+    /**
+     * @brief Check a bitboard for 3 in a row
+     * @param bits Bitboard of one player's tokens
+     * @return True if bits covers any winning line
+     */
+    static bool has_three_in_row(uint16_t bits);
+
+    /** @brief Legal moves of the side to move; returns the count */
+    int generate_moves(Move* moves) const;
+
+    void make(Move move) { tokens[side] ^= uint16_t(1u << (move >> 4) | 1u << (move & 15)); side ^= 1; }
+    void unmake(Move move) { side ^= 1; tokens[side] ^= uint16_t(1u << (move >> 4) | 1u << (move & 15)); }
+
+    /** @brief Open lines of the side to move minus the opponent's, weighted by tokens */
+    int evaluate() const;
+
+    /** @brief Mixed key of both bitboards and the side to move */
+    uint64_t hash() const {
+        uint64_t key = tokens[0] | uint64_t(tokens[1]) << 16 | uint64_t(side) << 32;
+        return Game_Random::splitmix64(key);
+    }
+
+    /** @brief Over once either side has 3 in a row; the game has no draws */
+    bool is_terminal(int& result) const {
+        result = has_three_in_row(tokens[side ^ 1]) ? -1 : has_three_in_row(tokens[side]) ? 1 : 0;
+        return result != 0;
+    }
+};
+
 /**
  * @class Game7_Board
  * @brief Board class for 4x4 moving token Tic-Tac-Toe
  * @details Manages a 4x4 board where players move their tokens to adjacent cells.
  *          Initial setup: Row 0 = O X O X, Row 3 = X O X O, middle rows empty.
  *          Win by forming 3 in a row horizontally, vertically, or diagonally.
- *          Includes Minimax AI with Alpha-Beta pruning for computer players.
+ *          Computer players search a Game7_Position with Search.
  */
 class Game7_Board : public Board<char> {
 private:
     char blank = '.';
 
     /**
-     * @brief Minimax algorithm with Alpha-Beta Pruning
-     * @param current_player Symbol of player making the current move
-     * @param ai_symbol Symbol of the AI player
-     * @param depth Current depth in the search tree
-     * @param max_depth Maximum depth to search
-     * @param alpha Best score the maximizer can guarantee
-     * @param beta Best score the minimizer can guarantee
-     * @return Evaluation score for the current position
-     * @details Recursively evaluates moves, pruning branches that cannot
-     *          affect the final decision to improve performance.
+     * @brief Pack the cells holding a symbol into a bitboard
+     * @param symbol The symbol to collect
+     * @return Mask with bit (row * 4 + column) set for every matching cell
      */
-    int minimax(char current_player, char ai_symbol, int depth, int max_depth,
-                int alpha, int beta);
+    uint16_t to_bitboard(char symbol) const;
 
     /**
      * @brief Helper to check win for a specific symbol
      * @param symbol The symbol to check ('X' or 'O')
      * @return True if symbol forms 3 in a row (any direction)
-     * @details Checks all horizontal, vertical, and diagonal lines
      */
     bool check_win_for_symbol(char symbol);
 
@@ -130,11 +193,12 @@ public:
     bool game_is_over(Player<char>* player) override;
 
     /**
-     * @brief Get best move using Minimax algorithm
+     * @brief Get best move from an alpha-beta search
      * @param ai_symbol Symbol of the AI player ('X' or 'O')
-     * @param difficulty Search depth (higher = smarter but slower)
+     * @param difficulty Plies searched after the AI's move (higher = smarter but slower)
      * @return Pointer to Game7_Move with optimal move
-     * @details Uses Alpha-Beta pruning for efficiency. Default difficulty is 5.
+     * @details Iterative deepening up to difficulty + 1 plies within a
+     *          3 second budget. Default difficulty is 5.
      *          Returns nullptr if no valid moves available.
      */
     Game7_Move* get_best_move(char ai_symbol, int difficulty = 5);
@@ -143,7 +207,7 @@ public:
 /**
  * @class Game7_Player
  * @brief Player class for Game7
- * @details Handles both human and computer players. Computer uses Minimax AI.
+ * @details Handles both human and computer players. Computer uses an alpha-beta search.
  */
 class Game7_Player : public Player<char> {
 public:
@@ -159,7 +223,7 @@ public:
     /**
      * @brief Get move from player
      * @return Pointer to Game7_Move object with chosen positions
-     * @details Computer players use Minimax AI at difficulty level 5
+     * @details Computer players search at difficulty level 9
      */
     Move<char>* get_move();
 };
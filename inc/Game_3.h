@@ -164,8 +164,8 @@ public:
      * @param symbol The player symbol to count sequences for ('X' or 'O')
      * @return The number of three-in-a-row sequences found
      *
-     * This helper function scans the board horizontally, vertically, and diagonally
-     * to count all instances of three consecutive symbols.
+     * Counts every instance of three consecutive symbols horizontally, vertically
+     * and diagonally, from a bitboard of the symbol's cells (see MNK_Lines).
      */
     int count_three_in_a_row(char symbol);
 
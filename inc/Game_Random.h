@@ -0,0 +1,176 @@
+/**
+ * @file Game_Random.h
+ * @brief Seedable random number generation shared by the games
+ * @details Game_Random is a xoshiro256** generator with unbiased bounded
+ *          sampling. Every thread draws from its own generator through
+ *          game_random(), so random players running in parallel never
+ *          contend on libc's hidden rand() state. Each thread's generator
+ *          is derived from one process seed and the order in which threads
+ *          first draw, so a game can be replayed exactly from the seed that
+ *          main() prints. Code that needs its own stream (a search worker,
+ *          a self-play game) constructs a Game_Random with an explicit seed,
+ *          or installs one for the current thread with Game_Random_Scope.
+ */
+
+#ifndef GAME_RANDOM_H
+#define GAME_RANDOM_H
+
+#include <atomic>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * @class Game_Random
+ * @brief Small, fast xoshiro256** generator
+ */
+class Game_Random {
+public:
+    /**
+     * @brief Creates a generator
+     * @param seed Any value; equal seeds give equal sequences
+     */
+    explicit Game_Random(uint64_t seed = 0) { reseed(seed); }
+
+    /**
+     * @brief Restarts the sequence from a seed
+     * @param seed Any value, spread over the state with splitmix64
+     */
+    void reseed(uint64_t seed) {
+        for (uint64_t& word : state) word = splitmix64(seed);
+    }
+
+    /** @brief Next 64 random bits */
+    uint64_t next() {
+        uint64_t result = rotl(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    /**
+     * @brief Uniform integer in [0, n) without modulo bias (Lemire's method)
+     * @param n Exclusive upper bound, at least 1
+     */
+    uint32_t below(uint32_t n) {
+        uint64_t m = uint64_t(uint32_t(next() >> 32)) * n;
+        uint32_t low = uint32_t(m);
+        if (low < n) {
+            uint32_t threshold = uint32_t(-n) % n;
+            while (low < threshold) {
+                m = uint64_t(uint32_t(next() >> 32)) * n;
+                low = uint32_t(m);
+            }
+        }
+        return uint32_t(m >> 32);
+    }
+
+    /**
+     * @brief Advances a splitmix64 counter and returns its scrambled value
+     * @param counter Counter, advanced in place
+     */
+    static uint64_t splitmix64(uint64_t& counter) {
+        uint64_t z = (counter += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief Sets the process seed and restarts the calling thread's generator
+     * @param seed Seed from which every thread's generator is derived
+     */
+    static void set_seed(uint64_t seed);
+
+    /** @brief Process seed from which every thread's generator is derived */
+    static uint64_t get_seed() { return process_seed().load(memory_order_relaxed); }
+
+private:
+    uint64_t state[4]; ///< Generator state, never all zero after reseed()
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    /** @brief Process seed shared by all threads */
+    static atomic<uint64_t>& process_seed() {
+        static atomic<uint64_t> seed{ 0 };
+        return seed;
+    }
+
+    friend struct Game_Random_Thread;
+};
+
+/**
+ * @struct Game_Random_Thread
+ * @brief The calling thread's default generator and the one currently in use
+ */
+struct Game_Random_Thread {
+    uint64_t stream;          ///< Order in which this thread first drew
+    Game_Random own;          ///< Generator derived from the process seed and stream
+    Game_Random* active;      ///< Generator returned by game_random()
+
+    Game_Random_Thread() : stream(next_stream()), own(derive(stream)), active(&own) {}
+
+    /** @brief Seed of a thread's generator */
+    static uint64_t derive(uint64_t stream) {
+        uint64_t counter = stream;
+        return Game_Random::get_seed() ^ Game_Random::splitmix64(counter);
+    }
+
+    /** @brief State of the calling thread */
+    static Game_Random_Thread& current() {
+        thread_local Game_Random_Thread thread;
+        return thread;
+    }
+
+private:
+    static uint64_t next_stream() {
+        static atomic<uint64_t> streams{ 0 };
+        return streams.fetch_add(1, memory_order_relaxed);
+    }
+};
+
+inline void Game_Random::set_seed(uint64_t seed) {
+    process_seed().store(seed, memory_order_relaxed);
+    Game_Random_Thread& thread = Game_Random_Thread::current();
+    thread.own.reseed(Game_Random_Thread::derive(thread.stream));
+}
+
+/**
+ * @brief Generator for the calling thread
+ * @return The generator installed by the innermost Game_Random_Scope, or
+ *         the thread's own generator derived from the process seed
+ */
+inline Game_Random& game_random() {
+    return *Game_Random_Thread::current().active;
+}
+
+/**
+ * @class Game_Random_Scope
+ * @brief Makes game_random() return a given generator on this thread until destroyed
+ */
+class Game_Random_Scope {
+public:
+    /**
+     * @brief Installs a generator for the calling thread
+     * @param rng Generator to use; must outlive the scope
+     */
+    explicit Game_Random_Scope(Game_Random& rng)
+        : previous(Game_Random_Thread::current().active) {
+        Game_Random_Thread::current().active = &rng;
+    }
+
+    ~Game_Random_Scope() { Game_Random_Thread::current().active = previous; }
+
+    Game_Random_Scope(const Game_Random_Scope&) = delete;
+    Game_Random_Scope& operator=(const Game_Random_Scope&) = delete;
+
+private:
+    Game_Random* previous; ///< Generator to restore
+};
+
+#endif // GAME_RANDOM_H
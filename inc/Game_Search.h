@@ -0,0 +1,354 @@
+/**
+ * @file Game_Search.h
+ * @brief Reusable alpha-beta search engine for two-player perfect-information games
+ * @details Search<Game> is negamax with principal variation search, a
+ *          transposition table, killer moves, a history heuristic,
+ *          aspiration windows and iterative deepening under a time budget.
+ *          A game plugs in by providing a small position type that models
+ *          the Search_Game concept: move generation, make and unmake, a
+ *          static evaluation, a hash and a terminal test. Every game that
+ *          uses the engine gets every improvement made to it.
+ */
+
+#ifndef GAME_SEARCH_H
+#define GAME_SEARCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @concept Search_Game
+ * @brief Position type that Search can play on
+ *
+ * - `Move` is an unsigned integer below `MOVE_SPACE`, used to index the
+ *   history table.
+ * - `generate_moves(list)` writes at most `MAX_MOVES` legal moves for the
+ *   side to move and returns how many; 0 with no terminal result is scored
+ *   as a draw.
+ * - `make(move)` plays a move and `unmake(move)` takes it back exactly.
+ * - `evaluate()` scores the position for the side to move, well inside
+ *   +-Search<Game>::MATE_BOUND.
+ * - `hash()` is a 64-bit key of the position including the side to move.
+ * - `is_terminal(result)` returns true when the game is over, with result
+ *   1, 0 or -1 for a win, draw or loss of the side to move.
+ */
+template <class G>
+concept Search_Game = requires(G game, const G& view, typename G::Move move, typename G::Move* list, int& result) {
+    requires is_unsigned_v<typename G::Move>;
+    { G::MAX_MOVES } -> convertible_to<int>;
+    { G::MOVE_SPACE } -> convertible_to<int>;
+    { view.generate_moves(list) } -> same_as<int>;
+    game.make(move);
+    game.unmake(move);
+    { view.evaluate() } -> same_as<int>;
+    { view.hash() } -> same_as<uint64_t>;
+    { view.is_terminal(result) } -> same_as<bool>;
+};
+
+/**
+ * @brief Search limits and tuning
+ */
+struct Search_Config {
+    int max_depth = 64;      ///< Deepest iterative-deepening iteration, in plies
+    int time_limit_ms = 0;   ///< Time budget per search in milliseconds (0 = none)
+    int tt_bits = 18;        ///< Transposition table holds 2^tt_bits entries
+    int aspiration = 32;     ///< Half-width of the aspiration window around the last score (0 = full window)
+};
+
+/**
+ * @brief Statistics of the last search
+ */
+struct Search_Stats {
+    long long nodes = 0;  ///< Positions visited
+    double seconds = 0;   ///< Wall-clock time spent searching
+    int depth = 0;        ///< Deepest completed iteration
+    int score = 0;        ///< Score of the chosen move for the side to move
+
+    /** @brief Search speed of the last search */
+    double nodes_per_second() const { return seconds > 0 ? nodes / seconds : 0; }
+};
+
+/**
+ * @class Search
+ * @brief Iterative-deepening alpha-beta engine over any Search_Game
+ * @tparam Game Position type
+ *
+ * Each iteration searches the previous best move first inside an
+ * aspiration window around the previous score, widening it on a fail.
+ * Inside the tree, moves are tried in the order: transposition table
+ * move, the two killer moves of the ply, then by history score. The
+ * first move gets the full window and the rest a null window, re-searched
+ * only if they beat alpha. Wins are scored WIN_SCORE minus the plies to
+ * the end, so the engine takes the quickest win and the slowest loss.
+ *
+ * The time manager does not start an iteration after half the budget is
+ * spent and aborts a running one when the budget is up; an aborted
+ * iteration is discarded. The table, killers and history are cleared
+ * before each search, so without a time limit the chosen move depends
+ * only on the position.
+ */
+template <Search_Game Game>
+class Search {
+public:
+    using Move = typename Game::Move;
+
+    static constexpr int WIN_SCORE = 1000000;           ///< Score of a win on the spot
+    static constexpr int MATE_BOUND = WIN_SCORE - 1000; ///< Scores beyond this are forced results
+    static constexpr int MAX_PLY = 128;                 ///< Deepest ply the engine reaches
+
+    /**
+     * @brief Construct an engine; the transposition table is allocated by the first search
+     * @param config Search limits and tuning
+     */
+    explicit Search(const Search_Config& config = Search_Config()) : config(config) {}
+
+    /**
+     * @brief Pick a move for the side to move
+     * @param root Position to search; searched on a copy
+     * @return Best move of the deepest completed iteration, or -1 if there is none
+     */
+    int search(const Game& root) {
+        start = chrono::steady_clock::now();
+        stats = Search_Stats();
+        aborted = false;
+
+        Game pos = root;
+        int result;
+        Move moves[Game::MAX_MOVES];
+        int count = pos.is_terminal(result) ? 0 : pos.generate_moves(moves);
+        if (count == 0) return -1;
+
+        size_t size = size_t(1) << max(config.tt_bits, 1);
+        if (table.size() != size)
+            table.assign(size, TT_Entry{});
+        else
+            fill(table.begin(), table.end(), TT_Entry{});
+        for (auto& pair : killers) pair[0] = pair[1] = NO_MOVE;
+        history.assign(Game::MOVE_SPACE, 0);
+
+        int best_move = moves[0];
+        int best_score = 0;
+        int max_depth = min(config.max_depth, MAX_PLY - 1);
+
+        for (int depth = 1; depth <= max_depth; depth++) {
+            if (depth > 1 && config.time_limit_ms > 0 && elapsed_ms() * 2 >= config.time_limit_ms)
+                break;
+
+            Move* previous_best = find(moves, moves + count, Move(best_move));
+            rotate(moves, previous_best, previous_best + 1);
+
+            int delta = config.aspiration;
+            bool windowed = depth > 1 && delta > 0 && abs(best_score) < MATE_BOUND;
+            int alpha = windowed ? best_score - delta : -INF_SCORE;
+            int beta = windowed ? best_score + delta : INF_SCORE;
+
+            int iteration_move, iteration_score;
+            while (true) {
+                iteration_score = search_root(pos, moves, count, depth, alpha, beta, iteration_move);
+                if (aborted) break;
+                if (iteration_score <= alpha && alpha > -INF_SCORE) {
+                    delta *= 4;
+                    alpha = delta < MATE_BOUND ? max(iteration_score - delta, -INF_SCORE) : -INF_SCORE;
+                } else if (iteration_score >= beta && beta < INF_SCORE) {
+                    delta *= 4;
+                    beta = delta < MATE_BOUND ? min(iteration_score + delta, INF_SCORE) : INF_SCORE;
+                } else {
+                    break;
+                }
+            }
+            if (aborted) break;
+
+            best_move = iteration_move;
+            best_score = iteration_score;
+            stats.depth = depth;
+            if (abs(best_score) >= MATE_BOUND) break;
+        }
+
+        stats.score = best_score;
+        stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return best_move;
+    }
+
+    /** @brief Statistics of the last search */
+    const Search_Stats& get_stats() const { return stats; }
+
+    /** @brief Search limits, editable between searches */
+    Search_Config& get_config() { return config; }
+
+private:
+    static constexpr int INF_SCORE = WIN_SCORE + 1;   ///< Beyond every real score
+    static constexpr Move NO_MOVE = Move(~Move(0));   ///< Empty killer or table move
+    enum : uint8_t { TT_EMPTY, TT_EXACT, TT_LOWER, TT_UPPER };
+
+    /** @brief Transposition table entry */
+    struct TT_Entry {
+        uint64_t key = 0;          ///< Full hash of the position
+        int32_t score = 0;         ///< Score, win scores stored relative to the node
+        int8_t depth = 0;          ///< Remaining depth the score was searched to
+        uint8_t flag = TT_EMPTY;   ///< EXACT, LOWER or UPPER bound
+        Move move = NO_MOVE;       ///< Best move found
+    };
+
+    Search_Config config;                       ///< Search limits and tuning
+    Search_Stats stats;                         ///< Statistics of the last search
+    vector<TT_Entry> table;                     ///< Transposition table
+    Move killers[MAX_PLY][2];                   ///< Two quiet moves per ply that caused a cutoff
+    vector<int> history;                        ///< Cutoff credit of each move, by move value
+    chrono::steady_clock::time_point start;     ///< Start of the current search
+    bool aborted = false;                       ///< Set when the time budget cut an iteration short
+
+    long long elapsed_ms() const {
+        return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    }
+
+    /** @brief Win scores are stored as distance from the node, not the root */
+    static int score_to_tt(int score, int ply) {
+        return score >= MATE_BOUND ? score + ply : score <= -MATE_BOUND ? score - ply : score;
+    }
+
+    static int score_from_tt(int score, int ply) {
+        return score >= MATE_BOUND ? score - ply : score <= -MATE_BOUND ? score + ply : score;
+    }
+
+    /**
+     * @brief Move the most promising remaining move to position i
+     * @details Selection instead of a full sort: a cutoff usually comes
+     *          from one of the first few moves.
+     */
+    void pick_move(Move* moves, int* scores, int count, int i) {
+        int best = i;
+        for (int j = i + 1; j < count; j++)
+            if (scores[j] > scores[best]) best = j;
+        swap(moves[i], moves[best]);
+        swap(scores[i], scores[best]);
+    }
+
+    /** @brief Credit a move that caused a beta cutoff */
+    void record_cutoff(Move move, int depth, int ply) {
+        if (killers[ply][0] != move) {
+            killers[ply][1] = killers[ply][0];
+            killers[ply][0] = move;
+        }
+        history[move] += depth * depth;
+    }
+
+    /**
+     * @brief One iteration at the root, in the given move order
+     * @param best_move Receives the best move of the iteration
+     * @return Score for the side to move; a fail-low or fail-high bound outside (alpha, beta)
+     */
+    int search_root(Game& pos, const Move* moves, int count, int depth, int alpha, int beta, int& best_move) {
+        int best_score = -INF_SCORE;
+        best_move = moves[0];
+        for (int i = 0; i < count; i++) {
+            pos.make(moves[i]);
+            int score;
+            if (i == 0) {
+                score = -negamax(pos, depth - 1, 1, -beta, -alpha);
+            } else {
+                score = -negamax(pos, depth - 1, 1, -alpha - 1, -alpha);
+                if (score > alpha && score < beta && !aborted)
+                    score = -negamax(pos, depth - 1, 1, -beta, -alpha);
+            }
+            pos.unmake(moves[i]);
+            if (aborted) return 0;
+
+            if (score > best_score) {
+                best_score = score;
+                best_move = moves[i];
+            }
+            if (score > alpha) alpha = score;
+            if (alpha >= beta) break;
+        }
+        return best_score;
+    }
+
+    /**
+     * @brief Negamax search with principal variation search
+     * @param pos Position to search, restored on return
+     * @param depth Remaining depth
+     * @param ply Distance from the root
+     * @param alpha Lower bound for the side to move
+     * @param beta Upper bound for the side to move
+     * @return Score for the side to move; 0 once the time budget aborts the search
+     */
+    int negamax(Game& pos, int depth, int ply, int alpha, int beta) {
+        stats.nodes++;
+        if (config.time_limit_ms > 0 && (stats.nodes & 1023) == 0 && elapsed_ms() >= config.time_limit_ms)
+            aborted = true;
+        if (aborted) return 0;
+
+        int result;
+        if (pos.is_terminal(result)) return result * (WIN_SCORE - ply);
+        if (depth <= 0 || ply >= MAX_PLY - 1) return pos.evaluate();
+
+        uint64_t key = pos.hash();
+        TT_Entry& entry = table[key & (table.size() - 1)];
+        Move tt_move = NO_MOVE;
+        if (entry.flag != TT_EMPTY && entry.key == key) {
+            tt_move = entry.move;
+            if (entry.depth >= depth) {
+                int score = score_from_tt(entry.score, ply);
+                if (entry.flag == TT_EXACT) return score;
+                if (entry.flag == TT_LOWER && score >= beta) return score;
+                if (entry.flag == TT_UPPER && score <= alpha) return score;
+            }
+        }
+
+        Move moves[Game::MAX_MOVES];
+        int count = pos.generate_moves(moves);
+        if (count == 0) return 0;
+
+        int scores[Game::MAX_MOVES];
+        for (int i = 0; i < count; i++) {
+            Move m = moves[i];
+            scores[i] = m == tt_move ? 1 << 30 :
+                        m == killers[ply][0] ? (1 << 29) + 1 :
+                        m == killers[ply][1] ? 1 << 29 : history[m];
+        }
+
+        int original_alpha = alpha;
+        int best_score = -INF_SCORE;
+        Move best_move = moves[0];
+        for (int i = 0; i < count; i++) {
+            pick_move(moves, scores, count, i);
+            pos.make(moves[i]);
+            int score;
+            if (i == 0) {
+                score = -negamax(pos, depth - 1, ply + 1, -beta, -alpha);
+            } else {
+                score = -negamax(pos, depth - 1, ply + 1, -alpha - 1, -alpha);
+                if (score > alpha && score < beta && !aborted)
+                    score = -negamax(pos, depth - 1, ply + 1, -beta, -alpha);
+            }
+            pos.unmake(moves[i]);
+            if (aborted) return 0;
+
+            if (score > best_score) {
+                best_score = score;
+                best_move = moves[i];
+            }
+            if (score > alpha) alpha = score;
+            if (alpha >= beta) {
+                record_cutoff(moves[i], depth, ply);
+                break;
+            }
+        }
+
+        entry.key = key;
+        entry.score = score_to_tt(best_score, ply);
+        entry.depth = int8_t(depth);
+        entry.flag = best_score <= original_alpha ? TT_UPPER : best_score >= beta ? TT_LOWER : TT_EXACT;
+        entry.move = best_move;
+        return best_score;
+    }
+};
+
+#endif // GAME_SEARCH_H
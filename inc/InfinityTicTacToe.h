@@ -7,11 +7,139 @@
 #define _INFINITY_TICTACTOE_H
 
 #include "BoardGame_Classes.h"
-#include <queue>
+#include "MNK_Board.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
 #include <utility>
 
 using namespace std;
 
+/// Lines of 3 on the 3x3 board, bit row * 3 + col
+using Infinity_Lines = MNK_Lines<3, 3, 3>;
+
+/**
+ * @struct Infinity_State
+ * @brief Marks of an Infinity position in placement order, with the vanish counter
+ *
+ * The order lives in a fixed ring buffer of 9 cells (row * 3 + col), so the
+ * state is a few bytes, trivially copyable and needs no allocation. Moves
+ * alternate, so the newest mark belongs to the player who just moved and
+ * the owners alternate back from it. key() packs the whole state into one
+ * integer for hashing and comparison.
+ */
+struct Infinity_State {
+    static const int CAPACITY = 9; ///< The board never holds more than 9 marks
+
+    uint8_t cells[CAPACITY] = {};  ///< Ring buffer of marked cells
+    uint8_t head = 0;              ///< Slot of the oldest mark
+    uint8_t length = 0;            ///< Number of marks
+    uint8_t counter = 0;           ///< Moves since the last vanish (0-2)
+
+    /** @brief Cell of the i-th oldest mark */
+    int at(int i) const { return cells[(head + i) % CAPACITY]; }
+
+    /** @brief Bitmask of the marked cells */
+    uint16_t occupied() const {
+        uint16_t mask = 0;
+        for (int i = 0; i < length; i++) mask |= 1 << at(i);
+        return mask;
+    }
+
+    /** @brief Bitmask of the cells marked by the player who moved last */
+    uint16_t last_mover() const {
+        uint16_t mask = 0;
+        for (int i = length - 1; i >= 0; i -= 2) mask |= 1 << at(i);
+        return mask;
+    }
+
+    /**
+     * @brief Marks an empty cell and makes the oldest mark vanish on every third move
+     * @param cell Empty cell (row * 3 + col)
+     * @return The cell that vanished, or -1
+     */
+    int place(int cell) {
+        cells[(head + length) % CAPACITY] = uint8_t(cell);
+        length++;
+        if (++counter < 3) return -1;
+
+        int vanished = cells[head];
+        head = uint8_t((head + 1) % CAPACITY);
+        length--;
+        counter = 0;
+        return vanished;
+    }
+
+    /**
+     * @brief Unique integer for the state: 4 bits per mark oldest first, then length and counter
+     */
+    uint64_t key() const {
+        uint64_t k = 0;
+        for (int i = 0; i < length; i++) k |= uint64_t(at(i)) << (4 * i);
+        return k | uint64_t(length) << 36 | uint64_t(counter) << 40;
+    }
+
+    bool operator==(const Infinity_State& other) const { return key() == other.key(); }
+};
+
+static_assert(is_trivially_copyable_v<Infinity_State>, "Infinity_State is copied with memcpy by search code");
+
+/**
+ * @brief Hash of an Infinity_State, for unordered containers
+ */
+template <>
+struct std::hash<Infinity_State> {
+    size_t operator()(const Infinity_State& state) const { return hash<uint64_t>()(state.key()); }
+};
+
+/**
+ * @class Infinity_Solver
+ * @brief Exact Infinity Tic-Tac-Toe solver built by retrograde analysis
+ *
+ * A position is an Infinity_State. The mark count and the counter fix
+ * the number of moves played (2 marks per 3 moves), so every move leads
+ * to the next layer and the board is full after move 13, where the
+ * player to move is stuck and the game is drawn.
+ *
+ * The table is filled layer by layer from move 13 back to the start:
+ * a position is won if some move wins at once or leads to a lost
+ * position, lost if every move leads to a won one, drawn otherwise, with
+ * the distance to the end under perfect play (fastest win, slowest loss).
+ * Each layer is indexed by the rank of the placement order among all
+ * orders of that length, one byte per position, about 1.4 MB in all.
+ * It is built on the first lookup.
+ */
+class Infinity_Solver {
+public:
+    /**
+     * @brief Game-theoretic value for the player to move
+     */
+    enum Result { DRAW = 0, WIN = 1, LOSS = 2 };
+
+    static const int MAX_MOVES = 13; ///< Moves after which the board is full
+
+    /**
+     * @brief Value of a position
+     * @param state Position to look up
+     * @param distance Receives the plies to the end of the game under perfect play
+     * @return Result for the player to move
+     */
+    static Result lookup(const Infinity_State& state, int& distance);
+
+    /**
+     * @brief Best move of a position
+     * @param state Position to play from
+     * @param result Receives the value for the player to move
+     * @param distance Receives the plies to the end of the game under perfect play
+     * @return Cell of the best move, or -1 if the board is full
+     */
+    static int best_move(const Infinity_State& state, Result& result, int& distance);
+
+    /** @brief Number of positions in the table */
+    static long long state_count();
+};
+
 /**
  * @class InfinityBoard
  * @brief 3x3 board where the oldest move vanishes every 3 turns
@@ -19,15 +147,18 @@ using namespace std;
 class InfinityBoard : public Board<char> {
 private:
     char blank = '.';
-    queue<pair<int, int>> move_history;
-    int move_counter;
+    Infinity_State state; ///< Placement order of the marks and the vanish counter
 
-    void remove_oldest_move();
     bool check_win_for_symbol(char symbol);
 
 public:
     InfinityBoard();
 
+    /**
+     * @brief Placement order of the marks and the vanish counter
+     */
+    const Infinity_State& get_state() const { return state; }
+
     /**
      * @brief Apply move and remove oldest if 3 moves have passed
      */
@@ -41,7 +172,9 @@ public:
     bool is_lose(Player<char>* player) override;
 
     /**
-     * @brief Always false (game continues indefinitely)
+     * @brief True when the board is full, so the next player cannot move
+     * @details Two marks are added every three moves, so this happens
+     *          after move 13 if nobody has won.
      */
     bool is_draw(Player<char>* player) override;
 
@@ -60,6 +193,11 @@ public:
      * @brief Get random valid move
      */
     Move<char>* get_random_move();
+
+    /**
+     * @brief Get the best move from Infinity_Solver
+     */
+    Move<char>* get_perfect_move();
 };
 
 /**
@@ -0,0 +1,353 @@
+/**
+ * @file MNK_Board.h
+ * @brief Compile-time m,n,k-game engine: bitboards, line tables and rule policies
+ * @details An m,n,k-game is played on an M x N grid and decided by lines of
+ *          K marks. Cell (row, col) is bit row * N + col of an unsigned
+ *          integer just wide enough for the board (16, 32, 64 or 128 bits).
+ *          MNK_Lines generates every line of K cells at compile time and
+ *          detects or counts complete lines with one shift-and-AND chain per
+ *          direction. MNKBoard adds a playable position whose rule policy
+ *          switches on gravity, misere, scoring by line count and vanishing
+ *          marks, so a new variant is a Rules struct and gets the same win
+ *          detection as every other board.
+ */
+
+#ifndef MNK_BOARD_H
+#define MNK_BOARD_H
+
+#include "Board_Geometry.h"
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+#if defined(__SIZEOF_INT128__)
+/// Unsigned integer with at least CELLS bits
+template <int CELLS>
+using MNK_Bits = conditional_t<CELLS <= 16, uint16_t,
+                 conditional_t<CELLS <= 32, uint32_t,
+                 conditional_t<CELLS <= 64, uint64_t, unsigned __int128>>>;
+#else
+/// Unsigned integer with at least CELLS bits (boards over 64 cells need __int128)
+template <int CELLS>
+using MNK_Bits = conditional_t<CELLS <= 16, uint16_t,
+                 conditional_t<CELLS <= 32, uint32_t, uint64_t>>;
+#endif
+
+/** @brief Number of set bits of a bitboard of any width */
+template <class Bits>
+constexpr int mnk_popcount(Bits bits) {
+    if constexpr (sizeof(Bits) <= 8) return popcount(bits);
+    else return popcount(uint64_t(bits)) + popcount(uint64_t(bits >> 64));
+}
+
+/** @brief Index of the lowest set bit of a non-empty bitboard */
+template <class Bits>
+constexpr int mnk_lowest(Bits bits) {
+    if constexpr (sizeof(Bits) <= 8) return countr_zero(bits);
+    else return uint64_t(bits) ? countr_zero(uint64_t(bits)) : 64 + countr_zero(uint64_t(bits >> 64));
+}
+
+/**
+ * @brief Cells of an M x N board where a line of K can start in each direction
+ * @return One bitboard per direction of LINE_DIRECTIONS
+ */
+template <int M, int N, int K>
+constexpr array<MNK_Bits<M * N>, 4> mnk_start_masks() {
+    array<MNK_Bits<M * N>, 4> starts{};
+    for (int d = 0; d < 4; d++) {
+        for (int row = 0; row < M; row++) {
+            for (int col = 0; col < N; col++) {
+                int end_row = row + (K - 1) * LINE_DIRECTIONS[d][0];
+                int end_col = col + (K - 1) * LINE_DIRECTIONS[d][1];
+                if (end_row < M && end_col >= 0 && end_col < N)
+                    starts[d] |= MNK_Bits<M * N>(1) << (row * N + col);
+            }
+        }
+    }
+    return starts;
+}
+
+/**
+ * @class MNK_Lines
+ * @brief Every line of K cells on an M x N board, and fast tests on them
+ * @tparam M Rows
+ * @tparam N Columns
+ * @tparam K Marks in a line
+ *
+ * The table is a constexpr value (MNK_LINE_TABLE), built once per board
+ * size at compile time. Lines are listed by start cell in reading order,
+ * then by direction: horizontal, vertical, diagonal, anti-diagonal.
+ */
+template <int M, int N, int K>
+class MNK_Lines {
+public:
+    static_assert(M > 0 && N > 0 && K > 0 && (K <= M || K <= N), "a line of K cells must fit on the board");
+    static_assert(M * N <= int(sizeof(MNK_Bits<M * N>)) * 8, "board too large for the widest bitboard");
+
+    static constexpr int CELLS = M * N;  ///< Cells on the board
+    using Bits = MNK_Bits<CELLS>;        ///< Bitboard type, one bit per cell
+
+    /// Bitboard with every cell set
+    static constexpr Bits FULL = CELLS == int(sizeof(Bits)) * 8 ? Bits(~Bits(0)) : Bits((Bits(1) << CELLS) - 1);
+
+    /// Number of lines on the board
+    static constexpr int COUNT = M * (N >= K ? N - K + 1 : 0) + (M >= K ? M - K + 1 : 0) * N +
+                                 2 * (M >= K ? M - K + 1 : 0) * (N >= K ? N - K + 1 : 0);
+
+    /// Most lines through any one cell: K per direction
+    static constexpr int PER_CELL = 4 * K;
+
+    array<Bits, COUNT> masks{};                            ///< Cells of each line
+    array<array<uint16_t, PER_CELL>, CELLS> through{};     ///< Lines through each cell
+    array<uint8_t, CELLS> through_count{};                 ///< Number of lines through each cell
+
+    constexpr MNK_Lines() {
+        int count = 0;
+        for (int row = 0; row < M; row++) {
+            for (int col = 0; col < N; col++) {
+                for (int d = 0; d < 4; d++) {
+                    if (!((STARTS[d] >> (row * N + col)) & 1)) continue;
+
+                    Bits mask = 0;
+                    for (int k = 0; k < K; k++) {
+                        int cell = (row + k * LINE_DIRECTIONS[d][0]) * N + col + k * LINE_DIRECTIONS[d][1];
+                        mask |= Bits(1) << cell;
+                        through[cell][through_count[cell]++] = uint16_t(count);
+                    }
+                    masks[count++] = mask;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Bitboard of one symbol's cells on a Board<T> matrix
+     * @param board M x N matrix, as returned by Board<T>::get_board_matrix()
+     * @param symbol Symbol to collect
+     */
+    template <class T>
+    static Bits marks_of(const vector<vector<T>>& board, T symbol) {
+        Bits marks = 0;
+        for (int row = 0; row < M; row++)
+            for (int col = 0; col < N; col++)
+                if (board[row][col] == symbol) marks |= Bits(1) << (row * N + col);
+        return marks;
+    }
+
+    /** @brief True if the marks contain a complete line */
+    static constexpr bool has_line(Bits marks) {
+        for (int d = 0; d < 4; d++)
+            if (line_starts(marks, d)) return true;
+        return false;
+    }
+
+    /** @brief Number of complete lines in the marks, overlapping lines counted separately */
+    static constexpr int count_lines(Bits marks) {
+        int count = 0;
+        for (int d = 0; d < 4; d++) count += mnk_popcount(line_starts(marks, d));
+        return count;
+    }
+
+    /**
+     * @brief True if the marks contain a complete line through a cell
+     * @details Only the lines through the cell are tested, so this is the
+     *          cheap check after a mark is placed there.
+     */
+    constexpr bool has_line_through(Bits marks, int cell) const {
+        for (int i = 0; i < through_count[cell]; i++) {
+            Bits mask = masks[through[cell][i]];
+            if ((marks & mask) == mask) return true;
+        }
+        return false;
+    }
+
+private:
+    /// Bit distance between neighbours in each direction
+    static constexpr int SHIFTS[4] = { 1, N, N + 1, N - 1 };
+
+    /// Cells where a line can start in each direction
+    static constexpr array<Bits, 4> STARTS = mnk_start_masks<M, N, K>();
+
+    /** @brief Start cells of the complete lines in direction d */
+    static constexpr Bits line_starts(Bits marks, int d) {
+        Bits starts = marks & STARTS[d];
+        for (int k = 1; k < K && starts; k++) starts &= marks >> (k * SHIFTS[d]);
+        return starts;
+    }
+};
+
+/// Line table of an M x N board with lines of K, built at compile time
+template <int M, int N, int K>
+inline constexpr MNK_Lines<M, N, K> MNK_LINE_TABLE{};
+
+/**
+ * @struct MNK_Rules
+ * @brief Default rule policy: first to complete a line wins, draw when the board fills
+ *
+ * A variant derives from this and overrides the constants it changes.
+ */
+struct MNK_Rules {
+    static constexpr bool GRAVITY = false;   ///< Marks drop to the lowest empty cell of their column
+    static constexpr bool MISERE = false;    ///< Completing a line loses instead of winning
+    static constexpr bool SCORING = false;   ///< Play to the end; more lines wins (fewer with MISERE)
+    static constexpr int MOVE_LIMIT = 0;     ///< Moves after which the game ends; 0 for no limit
+    static constexpr int VANISH_EVERY = 0;   ///< The oldest mark vanishes after every this many moves; 0 for never
+};
+
+/**
+ * @class MNKBoard
+ * @brief Bitboard position of an m,n,k-game under a rule policy
+ * @tparam M Rows
+ * @tparam N Columns
+ * @tparam K Marks in a line
+ * @tparam Rules Rule policy, MNK_Rules or a struct derived from it
+ *
+ * Sides are 0 (first player) and 1. The position is trivially copyable,
+ * so search code copies it instead of undoing moves.
+ */
+template <int M, int N, int K, class Rules = MNK_Rules>
+class MNKBoard {
+public:
+    using Lines = MNK_Lines<M, N, K>;   ///< Line table type
+    using Bits = typename Lines::Bits;  ///< Bitboard type
+    static constexpr int CELLS = M * N; ///< Cells on the board
+
+    /** @brief Empty board with the first player to move */
+    MNKBoard() = default;
+
+    /**
+     * @brief Position holding the given marks, for rules where move order does not matter
+     * @param first Marks of the first player
+     * @param second Marks of the second player
+     * @param blocked Cells no one may mark
+     * @details The side to move follows from the number of marks.
+     */
+    MNKBoard(Bits first, Bits second, Bits blocked = 0) requires (Rules::VANISH_EVERY == 0)
+        : stones{ first, second }, blocked(blocked), n_moves(mnk_popcount(Bits(first | second))) {}
+
+    /** @brief Cell index of (row, col), or -1 off the board */
+    static constexpr int cell(int row, int col) {
+        return (row < 0 || row >= M || col < 0 || col >= N) ? -1 : row * N + col;
+    }
+
+    /** @brief 0 if the first player is to move, 1 otherwise */
+    int side_to_move() const { return n_moves & 1; }
+
+    /** @brief Moves played so far */
+    int moves() const { return n_moves; }
+
+    /** @brief Marks of one side */
+    Bits marks(int side) const { return stones[side]; }
+
+    /** @brief Cells no one may mark */
+    Bits blocked_cells() const { return blocked; }
+
+    /** @brief Cells that are marked or blocked */
+    Bits occupied() const { return stones[0] | stones[1] | blocked; }
+
+    /** @brief Cells that are neither marked nor blocked */
+    Bits empty_cells() const { return Bits(Lines::FULL & ~occupied()); }
+
+    /** @brief Cells the side to move may mark: empty cells, or with gravity the lowest empty cell of each column */
+    Bits legal_moves() const {
+        if constexpr (Rules::GRAVITY) {
+            constexpr Bits BOTTOM_ROW = Bits(Lines::FULL >> (CELLS - N) << (CELLS - N));
+            return Bits(empty_cells() & ((occupied() >> N) | BOTTOM_ROW));
+        } else {
+            return empty_cells();
+        }
+    }
+
+    /** @brief Landing cell of a column under gravity, or -1 if it is full */
+    int drop(int col) const {
+        for (int row = M - 1; row >= 0; row--)
+            if (!((occupied() >> (row * N + col)) & 1)) return row * N + col;
+        return -1;
+    }
+
+    /** @brief Blocks an empty cell for both sides */
+    void block(int cell) { blocked |= Bits(1) << cell; }
+
+    /**
+     * @brief Marks a legal cell for the side to move
+     * @param cell Cell from legal_moves()
+     * @return The cell that vanished under VANISH_EVERY, or -1
+     */
+    int play(int cell) {
+        stones[n_moves & 1] |= Bits(1) << cell;
+        n_moves++;
+
+        if constexpr (Rules::VANISH_EVERY > 0) {
+            order[(head + length) % CELLS] = uint8_t(cell);
+            length++;
+            if (n_moves % Rules::VANISH_EVERY == 0) {
+                int vanished = order[head];
+                head = uint8_t((head + 1) % CELLS);
+                length--;
+                stones[0] &= ~(Bits(1) << vanished);
+                stones[1] &= ~(Bits(1) << vanished);
+                return vanished;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Takes back the last move, for rules where no mark vanishes
+     * @param cell Cell of the last move
+     */
+    void unplay(int cell) requires (Rules::VANISH_EVERY == 0) {
+        n_moves--;
+        stones[n_moves & 1] &= ~(Bits(1) << cell);
+    }
+
+    /** @brief Complete lines of one side */
+    int count_lines(int side) const { return Lines::count_lines(stones[side]); }
+
+    /** @brief True if one side has a complete line */
+    bool has_line(int side) const { return Lines::has_line(stones[side]); }
+
+    /** @brief True if one side has a complete line through a cell, the check after marking it */
+    bool has_line_through(int side, int cell) const {
+        return MNK_LINE_TABLE<M, N, K>.has_line_through(stones[side], cell);
+    }
+
+    /** @brief True if no more moves will be played */
+    bool is_over() const {
+        if (Rules::MOVE_LIMIT > 0 && n_moves >= Rules::MOVE_LIMIT) return true;
+        if (!legal_moves()) return true;
+        return !Rules::SCORING && (has_line(0) || has_line(1));
+    }
+
+    /**
+     * @brief Winner of a finished game
+     * @return 0 or 1, or -1 for a draw or a game still in progress
+     */
+    int winner() const {
+        if constexpr (Rules::SCORING) {
+            if (!is_over()) return -1;
+            int first = count_lines(0), second = count_lines(1);
+            if (first == second) return -1;
+            return (first > second) != Rules::MISERE ? 0 : 1;
+        } else {
+            for (int side = 0; side < 2; side++)
+                if (has_line(side)) return Rules::MISERE ? 1 - side : side;
+            return -1;
+        }
+    }
+
+private:
+    Bits stones[2] = { 0, 0 };  ///< Marks of each side
+    Bits blocked = 0;           ///< Cells no one may mark
+    int n_moves = 0;            ///< Moves played
+
+    array<uint8_t, (Rules::VANISH_EVERY > 0 ? CELLS : 0)> order{}; ///< Marks in placement order, as a ring (vanishing rules only)
+    uint8_t head = 0;           ///< Slot of the oldest mark
+    uint8_t length = 0;         ///< Marks in the ring
+};
+
+#endif // MNK_BOARD_H
@@ -6,12 +6,159 @@
 #define MEMORY_CLASSES_H
 
 #include "BoardGame_Classes.h"
+#include "Game_Random.h"
+#include "MNK_Board.h"
 #include <iostream>
 #include <iomanip>
 #include <cctype>
+#include <cstdint>
+#include <type_traits>
 #include <vector>
 using namespace std;
 
+/// Lines of 3 on the 3x3 board, bit x * 3 + y
+using Memory_Lines = MNK_Lines<3, 3, 3>;
+
+/**
+ * @struct Memory_Recall_Config
+ * @brief How well a computer player remembers the hidden marks
+ */
+struct Memory_Recall_Config {
+    int window = 0;         /**< Remember only the owners of the last this many moves; 0 for no limit */
+    double retention = 1.0; /**< Chance that each remembered owner survives another move; 1 never forgets */
+};
+
+/**
+ * @class Memory_Belief
+ * @brief A player's knowledge of who played where, as 9-bit cell masks
+ *
+ * Which cells are taken is visible on the board; only the owners are
+ * hidden. The belief is updated once per move: older memories first
+ * decay, each being forgotten with probability 1 - retention, then the
+ * new move is remembered and the move that falls out of the recall window
+ * is forgotten. A forgotten owner stays forgotten. The whole state is a
+ * few bytes with no heap storage, so simulations copy it freely.
+ */
+class Memory_Belief {
+public:
+    /**
+     * @brief Create an empty belief
+     * @param config Recall window and retention
+     */
+    explicit Memory_Belief(const Memory_Recall_Config& config = Memory_Recall_Config());
+
+    /**
+     * @brief Take in the next move of the game
+     * @param cell Cell played, x * 3 + y
+     * @param rng Generator deciding what is forgotten
+     */
+    void observe(int cell, Game_Random& rng);
+
+    /** @brief Moves observed so far */
+    int moves() const { return n_observed; }
+
+    /** @brief Cells taken, known or not, bit x * 3 + y */
+    uint16_t occupied() const { return taken; }
+
+    /** @brief Cells remembered as X */
+    uint16_t known_x() const { return known[0]; }
+
+    /** @brief Cells remembered as O */
+    uint16_t known_o() const { return known[1]; }
+
+    /** @brief Taken cells whose owner is not remembered */
+    uint16_t unknown() const { return taken & ~(known[0] | known[1]); }
+
+private:
+    uint16_t known[2] = { 0, 0 }; /**< Cells remembered as X and as O */
+    uint16_t taken = 0;           /**< Cells taken */
+    uint8_t order[9] = {};        /**< Cells in the order they were played */
+    uint8_t n_observed = 0;       /**< Moves observed */
+    uint8_t window;               /**< Recall window in moves, 9 for no limit */
+    uint32_t keep;                /**< Retention as a 32-bit threshold */
+};
+
+static_assert(is_trivially_copyable_v<Memory_Belief>, "Memory_Belief is copied freely by simulations");
+
+/**
+ * @struct Memory_ISMCTS_Config
+ * @brief Budget and tuning of the Memory Tic-Tac-Toe ISMCTS player
+ */
+struct Memory_ISMCTS_Config {
+    int playouts = 5000;        /**< Iterations per move */
+    double exploration = 0.7;   /**< UCT exploration constant */
+    int max_nodes = 1 << 16;    /**< Capacity of the node arena */
+};
+
+/**
+ * @class Memory_ISMCTS
+ * @brief Information-set Monte Carlo Tree Search for Memory Tic-Tac-Toe
+ *
+ * Every iteration samples a determinization, an assignment of owners to
+ * the occupied cells that agrees with the player's memory, the mark
+ * counts and the fact that nobody has won yet, and then runs one UCT
+ * iteration on it through a single shared tree. Occupancy is public, so
+ * every determinization has the same legal moves and the tree needs no
+ * availability counts. Nodes live in an arena allocated once and reset
+ * by every search.
+ */
+class Memory_ISMCTS {
+public:
+    /**
+     * @brief Create an engine
+     * @param config Budget and tuning
+     * @param seed Seed for determinizations and playouts
+     */
+    explicit Memory_ISMCTS(const Memory_ISMCTS_Config& config = Memory_ISMCTS_Config(),
+                           uint64_t seed = 0x9E3779B97F4A7C15ull);
+
+    /**
+     * @brief Choose a move for the player to move
+     * @param occupied Taken cells, bit x * 3 + y
+     * @param known_x Cells the player remembers as X
+     * @param known_o Cells the player remembers as O
+     * @return Most visited cell, or -1 if the board is full
+     */
+    int search(uint16_t occupied, uint16_t known_x, uint16_t known_o);
+
+    /** @brief Mean result of the chosen move in the last search (1 = win) */
+    double get_best_value() const { return best_value; }
+
+    /**
+     * @brief Sample owners for the occupied cells
+     * @param occupied Taken cells
+     * @param known_x Cells known to be X
+     * @param known_o Cells known to be O
+     * @param rng Generator
+     * @param x Receives the X cells
+     * @param o Receives the O cells
+     * @return false if no sample without a finished line was found; x and o are still filled
+     */
+    static bool determinize(uint16_t occupied, uint16_t known_x, uint16_t known_o, Game_Random& rng,
+                            uint16_t& x, uint16_t& o);
+
+private:
+    /**
+     * @brief Tree node; children of a node are stored contiguously
+     */
+    struct Node {
+        int first_child = -1;   /**< Arena index of the first child, -1 if not expanded */
+        uint8_t n_children = 0; /**< Number of children */
+        uint8_t move = 0;       /**< Cell played to reach this node */
+        uint32_t visits = 0;    /**< Iterations through this node */
+        double score = 0;       /**< Sum of results for the player who played the move */
+    };
+
+    Memory_ISMCTS_Config config;  /**< Budget and tuning */
+    Game_Random rng;              /**< Determinizations and playouts */
+    vector<Node> nodes;           /**< Node arena */
+    int node_count = 0;           /**< Nodes in use */
+    double best_value = 0;        /**< Mean result of the last chosen move */
+
+    /** @brief Expand a node with one child per empty cell, if the arena has room */
+    bool expand(int node, uint16_t occupied);
+};
+
 /**
  * @class Memory_Board
  * @brief Represents the Memory Tic-Tac-Toe board (3x3) with hidden cells.
@@ -22,7 +169,7 @@ using namespace std;
 class Memory_Board : public Board<char> {
 private:
     char blank_symbol = ' '; /**< Character for empty cell */
-    vector<tuple<int, int, char>> move_history; /**< Stores all moves: (x, y, symbol) */
+    uint8_t move_order[9] = {}; /**< Cells (x * 3 + y) in the order they were played; X moved first */
 
 public:
     /**
@@ -63,6 +210,40 @@ public:
      * @return True if game is over
      */
     bool game_is_over(Player<char>* player) override;
+
+    /**
+     * @brief Cell of a past move
+     * @param i Move number, from 0 to get_n_moves() - 1; even moves are X's
+     * @return Cell as x * 3 + y
+     */
+    int get_move_cell(int i) const { return move_order[i]; }
+};
+
+/**
+ * @class Memory_Player
+ * @brief Player that can search with ISMCTS from what it remembers
+ */
+class Memory_Player : public Player<char> {
+public:
+    /**
+     * @brief Create a player
+     * @param name Player name
+     * @param symbol 'X' or 'O'
+     * @param type Player type; AI players search with ISMCTS
+     * @param recall How well the player remembers the hidden marks
+     */
+    Memory_Player(string name, char symbol, PlayerType type,
+                  const Memory_Recall_Config& recall = Memory_Recall_Config());
+
+    /**
+     * @brief Update the memory and search for a move
+     * @return Chosen move
+     */
+    Move<char>* get_ismcts_move();
+
+private:
+    Memory_Belief memory;   /**< What the player remembers */
+    Memory_ISMCTS engine;   /**< Search engine, reused across moves */
 };
 
 /**
@@ -72,6 +253,14 @@ public:
 class Memory_UI : public UI<char> {
     private:
     char substitute = '#';
+    Memory_Recall_Config recall; ///< Recall of the player being set up, chosen by get_player_type_choice()
+
+protected:
+    /**
+     * @brief Choose the player type; choices 3-5 are ISMCTS players with perfect, fading or windowed recall
+     */
+    PlayerType get_player_type_choice(string player_label, const vector<string>& options) override;
+
 public:
     Memory_UI();
     ~Memory_UI() {};
@@ -80,6 +269,7 @@ public:
      */
     void display_board_matrix(const vector<vector<char>> &matrix) const override;
     Player<char>* create_player(string& name, char symbol, PlayerType type) override;
+
     Move<char>* get_move(Player<char>* player) override;
 };
 
@@ -7,13 +7,73 @@
  *
  * This file contains the class definitions for:
  * - Misere_TTT_Board: handles the board logic for Mis�re Tic-Tac-Toe
+ * - Misere_Solver: perfect play from a precomputed position table
  * - Misere_UI: handles user interface, player creation, and moves
  */
 
 #include "BoardGame_Classes.h"
+#include "MNK_Board.h"
 #include <cctype>
+#include <cstdint>
 using namespace std;
 
+/// Lines of 3 on the 3x3 board, bit row * 3 + col
+using Misere_Lines = MNK_Lines<3, 3, 3>;
+
+/**
+ * @class Misere_Solver
+ * @brief Perfect play for Misere Tic-Tac-Toe from a precomputed table.
+ *
+ * A board is encoded in base 3 (digit 0 empty, 1 'X', 2 'O' for cell
+ * row * 3 + col). Only one board of each group of 8 rotations and
+ * reflections is stored: the one with the smallest index. The table in
+ * Misere_Table.h holds every position reachable with X moving first that
+ * is not over yet, sorted by index, with the game-theoretic result and
+ * the best move in the stored orientation. It is generated by
+ * tools/misere_table_gen.cpp, which links only src/Misere_Solver.cpp
+ * (encoding and symmetries) so it builds without the table. A lookup
+ * is 8 re-encodings and a binary search over about 630 entries.
+ */
+class Misere_Solver {
+public:
+    /** @brief Game-theoretic result for the player to move */
+    enum Result { LOSS = 0, DRAW = 1, WIN = 2 };
+
+    static const int SYMMETRIES = 8; ///< Rotations and reflections of the square
+
+    /**
+     * @brief Cell that the given symmetry moves to position `cell`
+     * @param symmetry Symmetry index in 0..7 (0 is the identity)
+     * @param cell Cell in the transformed board as row * 3 + col
+     * @return Cell in the original board
+     */
+    static int source_cell(int symmetry, int cell);
+
+    /**
+     * @brief Base-3 index of a board
+     * @param board 3x3 board of 'X', 'O' and blanks
+     * @return Index in 0..3^9-1
+     */
+    static int encode(const vector<vector<char>>& board);
+
+    /**
+     * @brief Smallest index among the 8 symmetric images of a board
+     * @param index Base-3 index of the board
+     * @param symmetry Receives the symmetry that produces the smallest index
+     * @return Canonical index
+     */
+    static int canonicalize(int index, int& symmetry);
+
+    /**
+     * @brief Looks up perfect play for the player to move
+     * @param board 3x3 board with X having moved first
+     * @param cell Receives the best move as row * 3 + col
+     * @param result Receives the result with perfect play from both sides
+     * @return true if the position is in the table (reachable and not over)
+     */
+    static bool lookup(const vector<vector<char>>& board, int& cell, Result& result);
+};
+
 /**
  * @class Misere_TTT_Board
  * @brief Represents a 3x3 Mis�re Tic-Tac-Toe board.
@@ -101,14 +161,15 @@ public:
      * @brief Create a new player.
      * @param name Player's name
      * @param symbol Player's symbol (X or O)
-     * @param type Player type (HUMAN or COMPUTER)
+     * @param type Player type (HUMAN, COMPUTER or AI)
      * @return Player<char>* Pointer to the created player
      */
     Player<char>* create_player(string& name, char symbol, PlayerType type) override;
 
     /**
      * @brief Get a move from the player.
-     * For human players, input is requested. For AI players, a random move is generated.
+     * For human players, input is requested. Random computer players pick an
+     * empty cell at random, and AI players look up the perfect move.
      * @param player Pointer to the player
      * @return Move<char>* Pointer to the move
      */
@@ -0,0 +1,99 @@
+/**
+ * @file Misere_Table.h
+ * @brief Perfect-play table for Misere Tic-Tac-Toe, used by Misere_Solver.
+ *
+ * Generated by tools/misere_table_gen.cpp; do not edit by hand.
+ * Entry: canonical board index << 8 | result << 4 | best cell.
+ */
+
+#ifndef MISERE_TABLE_H
+#define MISERE_TABLE_H
+
+#include <cstdint>
+
+static constexpr int MISERE_TABLE_SIZE = 627; ///< Number of stored positions
+
+/// Positions sorted by canonical index
+static constexpr uint32_t MISERE_TABLE[MISERE_TABLE_SIZE] = {
+    0x000014, 0x000121, 0x000323, 0x000512, 0x000702, 0x000B11, 0x000E15, 0x001023,
+    0x002028, 0x002100, 0x002222, 0x002621, 0x002A20, 0x002C04, 0x002D00, 0x002E21,
+    0x003025, 0x003216, 0x003405, 0x003F00, 0x004021, 0x004225, 0x004427, 0x004604,
+    0x004C16, 0x005110, 0x005318, 0x005622, 0x005717, 0x005822, 0x005C21, 0x006203,
+    0x006803, 0x007220, 0x007402, 0x007D25, 0x007E21, 0x008016, 0x008326, 0x008406,
+    0x008527, 0x008E02, 0x009020, 0x009201, 0x009525, 0x009600, 0x009725, 0x009A01,
+    0x009C00, 0x009D25, 0x00A315, 0x00A527, 0x00A626, 0x00AC26, 0x00B027, 0x00B213,
+    0x00C010, 0x00C212, 0x00C412, 0x00C610, 0x00C811, 0x00CB15, 0x00CC10, 0x00CD15,
+    0x00D001, 0x00D227, 0x00D327, 0x00E216, 0x00E427, 0x011026, 0x011426, 0x011626,
+    0x011F26, 0x012227, 0x012526, 0x012914, 0x012A21, 0x012C20, 0x012E02, 0x013002,
+    0x013220, 0x013401, 0x013727, 0x013800, 0x013926, 0x013C01, 0x013E18, 0x013F26,
+    0x017A10, 0x017C18, 0x017F28, 0x018017, 0x018122, 0x018521, 0x018920, 0x018B07,
+    0x018C16, 0x018D21, 0x018F26, 0x019118, 0x019306, 0x01B000, 0x01B226, 0x01B517,
+    0x01B626, 0x01B718, 0x01BB26, 0x01C126, 0x01C727, 0x01CC16, 0x01CE17, 0x01CF26,
+    0x01D400, 0x01D526, 0x01D726, 0x01D927, 0x01DB16, 0x01E116, 0x022006, 0x022606,
+    0x026E06, 0x027006, 0x027126, 0x027727, 0x027B08, 0x027D07, 0x02E421, 0x02E820,
+    0x02EA03, 0x02EB14, 0x02EC21, 0x02EE25, 0x02F013, 0x02F204, 0x030525, 0x030621,
+    0x030827, 0x030B14, 0x030C04, 0x031E00, 0x031F25, 0x032211, 0x032410, 0x032514,
+    0x033C10, 0x033E13, 0x034123, 0x034217, 0x034323, 0x035917, 0x035D27, 0x037215,
+    0x037321, 0x037520, 0x037705, 0x037905, 0x038410, 0x038611, 0x038917, 0x038A10,
+    0x038B18, 0x038E01, 0x039015, 0x039127, 0x03A525, 0x03A725, 0x03A801, 0x03AB25,
+    0x03AD15, 0x03C128, 0x03C715, 0x03CE23, 0x03D222, 0x03D423, 0x03DD23, 0x03E013,
+    0x03E323, 0x03E400, 0x03E523, 0x03EF04, 0x03FB17, 0x03FF28, 0x040401, 0x040722,
+    0x040800, 0x040922, 0x040D21, 0x041120, 0x041307, 0x041414, 0x041521, 0x041720,
+    0x041904, 0x041B04, 0x042523, 0x043128, 0x043527, 0x045521, 0x045920, 0x045B07,
+    0x046510, 0x046718, 0x046A28, 0x046B17, 0x046C27, 0x047023, 0x047323, 0x047423,
+    0x047522, 0x047923, 0x047D13, 0x047F23, 0x048121, 0x048310, 0x048513, 0x048707,
+    0x048B01, 0x048F00, 0x049122, 0x049A07, 0x049B28, 0x049D27, 0x04A017, 0x04A128,
+    0x04A511, 0x04A720, 0x04A902, 0x04AB12, 0x04AD20, 0x04AF01, 0x04B227, 0x04B310,
+    0x04B418, 0x04B711, 0x04B910, 0x04BA17, 0x04C021, 0x04C413, 0x04C602, 0x04CA01,
+    0x04CD23, 0x04CE00, 0x04CF23, 0x04D201, 0x04D527, 0x04DC11, 0x04DF12, 0x04E002,
+    0x04E521, 0x04E920, 0x04EB07, 0x04EC14, 0x04EF24, 0x04F114, 0x04F601, 0x04F800,
+    0x04F927, 0x04FE00, 0x04FF21, 0x050120, 0x050307, 0x050507, 0x050B27, 0x051201,
+    0x051523, 0x051603, 0x051727, 0x052321, 0x052713, 0x052907, 0x052D21, 0x053120,
+    0x053307, 0x053D17, 0x053F27, 0x054217, 0x054327, 0x054721, 0x054920, 0x054B08,
+    0x054D07, 0x055901, 0x055B00, 0x055C27, 0x056201, 0x056527, 0x056B28, 0x056F27,
+    0x057128, 0x057727, 0x057F22, 0x058112, 0x058711, 0x058A17, 0x058B07, 0x059107,
+    0x05C823, 0x05E220, 0x05E305, 0x061601, 0x061800, 0x061923, 0x063320, 0x063508,
+    0x063707, 0x06A822, 0x06AA22, 0x06AC02, 0x06B021, 0x06B304, 0x06B400, 0x06B523,
+    0x06B801, 0x06BA00, 0x06BB23, 0x06C201, 0x06C522, 0x06C600, 0x06C722, 0x06CB21,
+    0x06CF20, 0x06D107, 0x06D200, 0x06D321, 0x06D520, 0x06D707, 0x06D907, 0x06DE00,
+    0x06DF22, 0x06E521, 0x06E724, 0x06EB04, 0x06F104, 0x06F801, 0x06FB22, 0x06FC00,
+    0x06FD22, 0x070121, 0x070520, 0x070707, 0x070921, 0x070B20, 0x070D08, 0x070F07,
+    0x072F22, 0x073302, 0x073B17, 0x073C27, 0x073F01, 0x074100, 0x074227, 0x074A23,
+    0x074B23, 0x075123, 0x075323, 0x075527, 0x075713, 0x076500, 0x076727, 0x076928,
+    0x076D01, 0x077027, 0x077110, 0x077218, 0x078107, 0x078707, 0x078907, 0x079C03,
+    0x07A203, 0x07B600, 0x07B724, 0x07BD24, 0x07BF24, 0x07C118, 0x07C317, 0x07C927,
+    0x07ED23, 0x07F321, 0x07F718, 0x07F903, 0x07FF03, 0x080720, 0x080902, 0x080B02,
+    0x080F18, 0x081228, 0x081317, 0x081427, 0x081701, 0x081900, 0x081A27, 0x082302,
+    0x082907, 0x082B08, 0x085907, 0x085F07, 0x086107, 0x09A126, 0x09AD04, 0x09BA14,
+    0x09BB22, 0x09BF21, 0x09C320, 0x09C504, 0x09C721, 0x09C920, 0x09CB06, 0x09CD04,
+    0x0A0B12, 0x0A0D28, 0x0A1628, 0x0A1928, 0x0A1D16, 0x0A1E26, 0x0A4116, 0x0A4326,
+    0x0A4C26, 0x0A4F21, 0x0A5206, 0x0A5D02, 0x0A6121, 0x0A6406, 0x0A6500, 0x0A6626,
+    0x0A6911, 0x0A6B10, 0x0A6C18, 0x0AAA00, 0x0AAB26, 0x0AB121, 0x0AB528, 0x0AB704,
+    0x0AFF02, 0x0B0308, 0x0B0826, 0x0C6B23, 0x0C9E24, 0x0CA101, 0x0CA424, 0x0CA514,
+    0x0CA624, 0x0CF228, 0x0CF618, 0x0D0A23, 0x0D0D23, 0x0D1023, 0x0D1223, 0x0D2801,
+    0x0D2C28, 0x0D3E20, 0x0D4008, 0x0D4221, 0x0D4420, 0x0D4608, 0x0D4808, 0x0D4F22,
+    0x0D5122, 0x0D5521, 0x0D5B03, 0x0D5D21, 0x0D6103, 0x0D6304, 0x0D6B20, 0x0D6D02,
+    0x0D7624, 0x0D7924, 0x0D7C24, 0x0D7D24, 0x0D8502, 0x0D8702, 0x0D8B01, 0x0D8E28,
+    0x0D8F00, 0x0D9028, 0x0D9321, 0x0D9520, 0x0D9604, 0x0DA303, 0x0DAF23, 0x0DB423,
+    0x0DBE28, 0x0DCA01, 0x0DCE00, 0x0DD700, 0x0DD822, 0x0DE421, 0x0DEA08, 0x0DF122,
+    0x0DF302, 0x0DF721, 0x0DFA03, 0x0DFC28, 0x0DFF21, 0x0E0203, 0x0E0C22, 0x0E0D02,
+    0x0E1221, 0x0E1620, 0x0E1808, 0x0E1E08, 0x0F4321, 0x0F4728, 0x0F4903, 0x0F6228,
+    0x0F6328, 0x0F6428, 0x0F9528, 0x0F9A23, 0x0FD008, 0x102D23, 0x103118, 0x103313,
+    0x103923, 0x104302, 0x104512, 0x104918, 0x104C28, 0x104D10, 0x104E14, 0x105121,
+    0x105404, 0x106304, 0x107B02, 0x107F18, 0x108423, 0x108703, 0x109512, 0x109622,
+    0x109A28, 0x109E10, 0x10A018, 0x10A221, 0x10A808, 0x10B421, 0x10BA08, 0x10CF18,
+    0x10EA28, 0x10EE18, 0x10F018, 0x138D01, 0x15DF28, 0x15E303, 0x15E508, 0x15EB04,
+    0x15FE28, 0x163901, 0x163C23, 0x165818, 0x167208, 0x168128, 0x16A018, 0x193008,
+    0x1C8B23, 0x1C8E13, 0x1C9123, 0x1CA914, 0x1CC104, 0x1CC321, 0x1CC704, 0x1CC905,
+    0x1CDF13, 0x1D1515, 0x1D1825, 0x1D2721, 0x1D2D03, 0x1D3303, 0x1D4825, 0x1D4B15,
+    0x1D4E25, 0x1D6205, 0x1D6511, 0x1D6817, 0x1DB714, 0x1DBA24, 0x1DBC24, 0x1E0817,
+    0x1E3E17, 0x1E5821, 0x1E5C07, 0x1E5E07, 0x1EA101, 0x1EA427, 0x1EA627, 0x1EFE07,
+    0x1F6601, 0x1F6923, 0x1F8504, 0x1F8705, 0x1FBB03, 0x1FD625, 0x205D27, 0x205F03,
+    0x207527, 0x207827, 0x207A27, 0x208F01, 0x209227, 0x20AB27, 0x20AE27, 0x214713,
+    0x214903, 0x215F11, 0x216214, 0x216427, 0x216A27, 0x219511, 0x219817, 0x21B011,
+    0x21B617, 0x21BC07, 0x220417, 0x220617, 0x28E521, 0x28E803, 0x292004, 0x293601,
+    0x29D214, 0x29F014, 0x29F604, 0x29F804, 0x2A0A04, 0x2A1004, 0x2A2613, 0x2A4401,
+    0x2A7413, 0x2FBC04, 0x42A404,
+};
+
+#endif // MISERE_TABLE_H
@@ -7,11 +7,53 @@
 #define _NUMERICAL_TICTACTOE_H
 
 #include "BoardGame_Classes.h"
-#include <set>
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 using namespace std;
 
+/**
+ * @class NumericalSolver
+ * @brief Memoized exhaustive solver for Numerical Tic-Tac-Toe
+ *
+ * A position is the 36-bit board state of NumericalBoard: 4 bits per cell
+ * (cell row * 3 + col at bit 4 * cell) holding 0 for empty or the number
+ * placed. The used numbers and the player to move (odd moves first) follow
+ * from it. Scores are negamax values for the player to move: a win is
+ * worth 10 minus the numbers already on the board when the winning number
+ * is placed, so sooner wins score higher, and a draw is 0. Results are memoized by the smallest
+ * of the 8 rotated and reflected states, since the board symmetries map
+ * lines to lines.
+ */
+class NumericalSolver {
+public:
+    /**
+     * @brief Perfect-play score for the player to move
+     * @param state Board state of a position that is not over
+     */
+    static int score(uint64_t state);
+
+    /**
+     * @brief Best move for the player to move
+     * @param state Board state of a position that is not over
+     * @param cell Receives the cell as row * 3 + col
+     * @param number Receives the number to place
+     * @return Score of the move for the player to move
+     */
+    static int best_move(uint64_t state, int& cell, int& number);
+
+    /** @brief Number of positions solved so far */
+    static size_t solved_positions();
+
+private:
+    /** @brief Memo from canonical state to score, filled on first use */
+    static unordered_map<uint64_t, int8_t>& memo();
+
+    /** @brief Smallest state among the 8 symmetric images */
+    static uint64_t canonical(uint64_t state);
+};
+
 /**
  * @class NumericalBoard
  * @brief 3x3 board using numbers (odd: 1-9, even: 2-8)
@@ -19,8 +61,8 @@ using namespace std;
 class NumericalBoard : public Board<int> {
 private:
     bool currentMoveIsOdd;
-    set<int> used_numbers_odd;
-    set<int> used_numbers_even;
+    uint16_t used_numbers = 0; ///< Bit n set once number n is on the board
+    uint64_t state = 0;        ///< Board packed 4 bits per cell, see NumericalSolver
     int blank = 0;
 
     bool check_sum_15(int a, int b, int c);
@@ -55,6 +97,11 @@ public:
     bool is_number_used(int num, bool isOdd);
 
     void set_current_player_odd(bool odd) { currentMoveIsOdd = odd; }
+
+    /**
+     * @brief Board packed 4 bits per cell, as used by NumericalSolver
+     */
+    uint64_t get_state() const { return state; }
 };
 
 /**
@@ -87,6 +134,11 @@ public:
      */
     Move<int>* get_random_move();
 
+    /**
+     * @brief Get the solver's perfect move for AI player
+     */
+    Move<int>* get_perfect_move();
+
     void set_chosen_number(int num) { chosen_number = num; }
     int get_chosen_number() const { return chosen_number; }
     bool is_odd_player() const { return isOdd; }
@@ -2,35 +2,85 @@
 #define PYRAMID_CLASSES_H
 
 #include "BoardGame_Classes.h"
+#include "Board_Geometry.h"
 #include <array>
+#include <cstdint>
 #include <vector>
 #include <utility>
 #include <cctype>
 using namespace std;
 
+/**
+ * @struct Pyramid_Solution
+ * @brief Perfect play from one Pyramid position
+ */
+struct Pyramid_Solution {
+    int8_t value; ///< Outcome for the player to move: 0 draw, else +/-(1 + empty cells left at the end)
+    int8_t cell;  ///< Dense cell index of the best move, or -1 if the game is over
+};
+
+/**
+ * @class Pyramid_Solver
+ * @brief Exact Pyramid solver backed by a table built on first use
+ *
+ * A position is indexed in base 3 over the 9 dense cells (digit 0 empty,
+ * 1 X, 2 O), giving 3^9 states; X moves first, so the player to move
+ * follows from the number of marks. A move always raises the index, so the
+ * table is filled backwards from the full boards in one pass. It is built
+ * once per process on the first lookup and shared by every board, after
+ * which each move is a single lookup. Faster wins and slower losses score
+ * higher in magnitude.
+ */
+class Pyramid_Solver {
+public:
+    static const int STATES = 19683; ///< Number of board states, 3^9
+
+    /**
+     * @brief Value of a cell in the base-3 index
+     * @param cell Dense cell index (0-8)
+     * @return 3 to the power of `cell`
+     */
+    static int cell_weight(int cell);
+
+    /**
+     * @brief Perfect play from a position
+     * @param state Base-3 index of the board
+     * @return Best move and its value for the player to move
+     */
+    static const Pyramid_Solution& lookup(int state);
+
+    /**
+     * @brief Row of a dense cell on the 3x5 board
+     */
+    static int row_of(int cell);
+
+    /**
+     * @brief Column of a dense cell on the 3x5 board
+     */
+    static int col_of(int cell);
+};
+
 /**
  * @class Pyramid_Board
  * @brief Represents the Pyramid-shaped Tic-Tac-Toe board.
  *
  * The board has 3 rows and 5 columns. Certain cells are marked as invalid,
- * forming a pyramid shape. Winning lines are predefined triples of cells.
+ * forming a pyramid shape. The 9 playable cells are numbered densely by
+ * Board_Geometry, each player's marks are kept as a 9-bit bitboard, and the
+ * winning lines are every 3-cell line of the shape, generated at compile time.
  */
 class Pyramid_Board : public Board<char> {
 private:
     char blank_symbol = '.';      ///< Character used to mark empty playable cells.
     char invalid_blank = '#';     ///< Character used to mark invalid cells.
-    vector<array<pair<int, int>, 3>> winning_lines; ///< All possible winning triples.
+    uint64_t stones[2] = { 0, 0 }; ///< Bitboards of X's and O's marks over the dense cells.
+    int state = 0;                 ///< Base-3 index of the board, see Pyramid_Solver.
 
     /**
      * @brief Initialize all board cells with blank and invalid symbols.
      */
     void init_board();
 
-    /**
-     * @brief Define all possible winning lines for the pyramid shape.
-     */
-    void init_winning_lines();
-
 public:
     /**
      * @brief Construct a Pyramid board and initialize it.
@@ -79,6 +129,12 @@ public:
      * @return true if the cell is playable.
      */
     bool is_playable_cell(int x, int y) const;
+
+    /**
+     * @brief Get the base-3 index of the board for Pyramid_Solver.
+     * @return Index in [0, Pyramid_Solver::STATES).
+     */
+    int get_state() const { return state; }
 };
 
 /**
@@ -101,7 +157,7 @@ public:
      * @brief Create a player object.
      * @param name Player's name.
      * @param symbol Player's symbol (X or O).
-     * @param type Player type (HUMAN or COMPUTER).
+     * @param type Player type (HUMAN, COMPUTER or AI).
      * @return Pointer to the created Player object.
      */
     Player<char>* create_player(string& name, char symbol, PlayerType type) override;
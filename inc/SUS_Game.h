@@ -7,10 +7,59 @@
 #define SUS_GAME_H
 
 #include "BoardGame_Classes.h"
+#include <cstdint>
 #include <vector>
 
 using namespace std;
 
+/**
+ * @struct SUS_Solution
+ * @brief Perfect play from one board position
+ */
+struct SUS_Solution {
+    int8_t value;  /**< Best (own - opponent) points still to come for the player to move */
+    uint8_t cell;  /**< Cell of the best move as row * 3 + col, or 9 on a full board */
+    char letter;   /**< Letter of the best move ('S' or 'U') */
+};
+
+/**
+ * @class SUS_Solver
+ * @brief Exact solver for SUS backed by a table built on first use
+ *
+ * A board is indexed in base 3 (digit 0 empty, 1 'S', 2 'U' for cell
+ * row * 3 + col), giving 3^9 states. The points still to be scored depend
+ * only on the board, never on the score so far, so maximizing the final
+ * margin from each board is also the best play for a win or a draw,
+ * whatever the current score. The table is filled backwards from the full
+ * boards, since a move always raises the index, after which every move
+ * is a single lookup.
+ */
+class SUS_Solver {
+public:
+    static const int STATES = 19683; /**< Number of board states, 3^9 */
+
+    /**
+     * @brief Base-3 digit of a cell content
+     * @param letter Cell content ('S', 'U' or anything else for empty)
+     * @return 1 for 'S', 2 for 'U', 0 otherwise
+     */
+    static int letter_digit(char letter) { return letter == 'S' ? 1 : letter == 'U' ? 2 : 0; }
+
+    /**
+     * @brief Value of a cell in the base-3 index
+     * @param cell Cell as row * 3 + col
+     * @return 3 to the power of `cell`
+     */
+    static int cell_weight(int cell);
+
+    /**
+     * @brief Perfect play from a board
+     * @param state Base-3 index of the board
+     * @return Best move and its value for the player to move
+     */
+    static const SUS_Solution& lookup(int state);
+};
+
 /**
  * @class SUS_Board
  * @brief Represents the SUS game board (3x3)
@@ -26,18 +75,15 @@ private:
     int Total_SUS = 0; /**< Total number of S-U-S sequences on the board */
     int score_X = 0;   /**< Score for player X */
     int score_O = 0;   /**< Score for player O */
+    int state = 0;     /**< Base-3 index of the board, see SUS_Solver */
 
     /**
-     * @brief Count total number of S-U-S sequences on the board
-     * @return Total count of complete S-U-S patterns
-     */
-    int count_total_sus();
-
-    /**
-     * @brief Check for new S-U-S sequences and update player score
-     * @param player_symbol The symbol of the player who just moved ('X' or 'O')
+     * @brief Count the complete S-U-S sequences through one cell
+     * @param x Row of the cell
+     * @param y Column of the cell
+     * @return Number of complete S-U-S lines among the 2 to 4 lines through the cell
      */
-    void check_and_count_sus(char player_symbol);
+    int count_sus_through(int x, int y) const;
 
 public:
     /**
@@ -52,6 +98,30 @@ public:
      */
     bool update_board(Move<char>* move) override;
 
+    /**
+     * @brief Place a letter without validation or output and score it
+     *
+     * Only the lines through the cell are examined, and each complete one is
+     * new because the cell was empty. Intended for search; update_board()
+     * validates and reports moves for play.
+     *
+     * @param x Row of an empty cell
+     * @param y Column of an empty cell
+     * @param letter 'S' or 'U'
+     * @return Points gained by the player making the move
+     */
+    int make_move(int x, int y, char letter);
+
+    /**
+     * @brief Take back the last move made, restoring the board and the scores
+     *
+     * Moves must be taken back in the reverse order they were made.
+     *
+     * @param x Row of the last move
+     * @param y Column of the last move
+     */
+    void unmake_move(int x, int y);
+
     /**
      * @brief Check if a player has won the game
      * @param player Pointer to the player to check
@@ -91,6 +161,12 @@ public:
      * @return Score of player O
      */
     int get_score_O() const { return score_O; }
+
+    /**
+     * @brief Get the base-3 index of the board used by SUS_Solver
+     * @return Board index in 0..3^9-1
+     */
+    int get_state() const { return state; }
 };
 
 /**
@@ -114,7 +190,7 @@ public:
      * @brief Construct a SUS player
      * @param n Player name
      * @param s Player symbol ('X' or 'O')
-     * @param t Player type (HUMAN or COMPUTER)
+     * @param t Player type (HUMAN, COMPUTER or AI)
      */
     SUS_Player(string n, char s, PlayerType t);
 
@@ -124,6 +200,12 @@ public:
      */
     Move<char>* get_random_move();
 
+    /**
+     * @brief Look up the perfect move for the current board
+     * @return Pointer to the Move maximizing this player's final margin
+     */
+    Move<char>* get_perfect_move();
+
     /**
      * @brief Set the letter to be placed in the next move
      * @param letter The letter to place ('S' or 'U')
@@ -154,7 +236,7 @@ public:
      * @brief Create a player for the game
      * @param name Player's name
      * @param symbol Player's symbol ('X' or 'O')
-     * @param type Player type (HUMAN or COMPUTER)
+     * @param type Player type (HUMAN, COMPUTER or AI)
      * @return Pointer to the created SUS_Player object
      */
     Player<char>* create_player(string& name, char symbol, PlayerType type) override;
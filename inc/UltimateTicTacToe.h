@@ -6,6 +6,12 @@
 #include <cstdlib>
 #include <ctime>
 #include <vector>
+#include <array>
+#include <cstdint>
+#include <bit>
+#include <chrono>
+#include <atomic>
+#include <memory>
 
 using namespace std;
 
@@ -14,6 +20,372 @@ template <typename T> class Ultimate_TTT_Board;
 template <typename T> class Ultimate_TTT_UI;
 template <typename T> class Ultimate_TTT_Random_Player;
 
+/**
+ * @brief Build the lookup table of won 3x3 grids
+ * @return Table whose entry m is true if the 9-bit mask m has three in a row
+ * @details Bit (row * 3 + column) of a mask stands for one cell of the grid.
+ */
+constexpr array<bool, 512> make_ultimate_win_table() {
+    const uint16_t lines[8] = { 0x007, 0x038, 0x1C0, 0x049, 0x092, 0x124, 0x111, 0x054 };
+    array<bool, 512> table{};
+    for (int mask = 0; mask < 512; mask++)
+        for (uint16_t line : lines)
+            if ((mask & line) == line)
+                table[mask] = true;
+    return table;
+}
+
+/// Entry m is true if the 9-bit cell mask m contains three in a row
+inline constexpr array<bool, 512> ULTIMATE_WIN_TABLE = make_ultimate_win_table();
+
+/**
+ * @brief Bitboard layout of an Ultimate Tic Tac Toe position
+ *
+ * Sub-boards and cells are numbered row * 3 + column. Every player owns
+ * a 9-bit mask per sub-board, and the main board is one 9-bit mask of
+ * won sub-boards per player, so applying a move and checking for a win
+ * are a few bit operations and table lookups. The struct is trivially
+ * copyable, which lets search players clone positions cheaply.
+ */
+struct Ultimate_TTT_Bitboard {
+    static const uint16_t FULL = 0x1FF;  ///< Mask with all 9 bits set
+
+    uint16_t cells[2][9] = {};  ///< Occupied cells per player per sub-board
+    uint16_t won[2] = {};       ///< Sub-boards won by each player (the main board)
+    uint16_t closed = 0;        ///< Sub-boards that are won or full
+    int8_t active = -1;         ///< Sub-board the next move must use, -1 for any
+    uint8_t side = 0;           ///< Player to move (0 or 1)
+
+    /** @brief Mask of the sub-boards the next move may use */
+    uint16_t playable_sub_boards() const {
+        return active >= 0 ? uint16_t(1u << active) : uint16_t(FULL & ~closed);
+    }
+
+    /** @brief Mask of the empty cells of one sub-board */
+    uint16_t empty_cells(int sub) const {
+        return uint16_t(FULL & ~(cells[0][sub] | cells[1][sub]));
+    }
+
+    /** @brief Check if the player to move may play at (sub, cell) */
+    bool is_legal(int sub, int cell) const {
+        return (playable_sub_boards() >> sub & 1) && (empty_cells(sub) >> cell & 1);
+    }
+
+    /**
+     * @brief Apply a move for the player to move and pass the turn
+     * @param sub Sub-board index (0-8)
+     * @param cell Cell index inside the sub-board (0-8)
+     * @details Does not validate the move; call is_legal() first.
+     */
+    void play(int sub, int cell) {
+        uint16_t bit = uint16_t(1u << sub);
+        cells[side][sub] |= uint16_t(1u << cell);
+        if (ULTIMATE_WIN_TABLE[cells[side][sub]]) {
+            won[side] |= bit;
+            closed |= bit;
+        } else if (empty_cells(sub) == 0) {
+            closed |= bit;
+        }
+        active = (closed >> cell & 1) ? int8_t(-1) : int8_t(cell);
+        side ^= 1;
+    }
+
+    /** @brief Check if a player has three won sub-boards in a row */
+    bool has_won(int player) const { return ULTIMATE_WIN_TABLE[won[player]]; }
+
+    /** @brief Check if no sub-board can take another move */
+    bool all_closed() const { return closed == FULL; }
+
+    /** @brief Check if the player who just moved won or the board is closed */
+    bool is_terminal() const { return has_won(side ^ 1) || all_closed(); }
+
+    /** @brief Number of legal moves for the player to move */
+    int count_moves() const {
+        int count = 0;
+        for (uint16_t subs = playable_sub_boards(); subs; subs &= subs - 1)
+            count += popcount(empty_cells(countr_zero(subs)));
+        return count;
+    }
+
+    /**
+     * @brief Get one legal move by its position in generation order
+     * @param n Index of the move, 0 <= n < count_moves()
+     * @return The move encoded as sub * 9 + cell
+     */
+    int nth_move(int n) const {
+        for (uint16_t subs = playable_sub_boards(); subs; subs &= subs - 1) {
+            int sub = countr_zero(subs);
+            uint16_t empty = empty_cells(sub);
+            int count = popcount(empty);
+            if (n < count) {
+                for (; n > 0; n--)
+                    empty &= empty - 1;
+                return sub * 9 + countr_zero(empty);
+            }
+            n -= count;
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Write every legal move into a buffer
+     * @param out Buffer of at least 81 entries, filled with sub * 9 + cell
+     * @return Number of moves written
+     */
+    int generate_moves(uint8_t* out) const {
+        int count = 0;
+        for (uint16_t subs = playable_sub_boards(); subs; subs &= subs - 1) {
+            int sub = countr_zero(subs);
+            for (uint16_t empty = empty_cells(sub); empty; empty &= empty - 1)
+                out[count++] = uint8_t(sub * 9 + countr_zero(empty));
+        }
+        return count;
+    }
+};
+
+/**
+ * @brief Search budget and tuning for the Ultimate Tic Tac Toe MCTS player
+ */
+struct Ultimate_TTT_MCTS_Config {
+    long long max_playouts = 200000;  ///< Stop after this many playouts (all threads together)
+    int time_limit_ms = 1000;         ///< Stop after this many milliseconds (0 = no limit)
+    double exploration = 1.0;         ///< UCT exploration constant
+    int max_nodes = 1 << 21;          ///< Capacity of the node arena
+    int threads = 1;                  ///< Number of search threads
+    bool root_parallel = false;       ///< Give every thread its own tree and merge the roots
+    int virtual_loss = 1;             ///< Losses charged to a path while a tree-parallel playout runs
+};
+
+/**
+ * @brief Statistics of the last search, for tuning against a latency budget
+ */
+struct Ultimate_TTT_Search_Stats {
+    long long playouts = 0;  ///< Playouts run
+    double seconds = 0;      ///< Wall-clock time spent searching
+    int nodes = 0;           ///< Arena nodes in use when the search stopped
+    int best_visits = 0;     ///< Visits of the chosen root move
+    double best_value = 0;   ///< Mean result of the chosen root move (1 = win)
+
+    /** @brief Playout throughput of the last search */
+    double playouts_per_second() const { return seconds > 0 ? playouts / seconds : 0; }
+};
+
+/**
+ * @brief Monte Carlo Tree Search (UCT) engine for Ultimate Tic Tac Toe
+ *
+ * Runs on Ultimate_TTT_Bitboard positions. Tree nodes live in a single
+ * arena that is allocated once and reused across searches, so growing the
+ * tree never calls new. Leaves are scored with uniformly random playouts.
+ * When the arena is full the tree stops growing and the remaining budget
+ * is spent on playouts from existing leaves.
+ *
+ * With more than one thread the engine runs either tree parallelism, where
+ * all threads share the arena through atomic counters and a virtual loss
+ * steers them onto different paths, or root parallelism, where every thread
+ * grows a private tree and the root statistics are summed at the end.
+ */
+class Ultimate_TTT_MCTS {
+public:
+    /**
+     * @brief Construct an engine
+     * @param config Search budget and tuning
+     * @param seed Seed for the playout random number generators
+     */
+    explicit Ultimate_TTT_MCTS(const Ultimate_TTT_MCTS_Config& config = Ultimate_TTT_MCTS_Config(),
+                               uint64_t seed = 0x9E3779B97F4A7C15ull);
+
+    /**
+     * @brief Search a position and pick a move for the player to move
+     * @param root Position to search
+     * @return Most visited move encoded as sub * 9 + cell, or -1 if the game is over
+     */
+    int search(const Ultimate_TTT_Bitboard& root);
+
+    /** @brief Statistics of the last search */
+    const Ultimate_TTT_Search_Stats& get_stats() const { return stats; }
+
+    /** @brief Search budget and tuning, editable between searches */
+    Ultimate_TTT_MCTS_Config& get_config() { return config; }
+
+private:
+    /**
+     * @brief Tree node stored in the arena
+     * @details score is counted for the player who made move. Counters are
+     *          atomic so tree-parallel workers can update them without locks.
+     */
+    struct Node {
+        atomic<int32_t> first_child;  ///< Arena index of the first child, LEAF or EXPANDING
+        atomic<uint32_t> visits;      ///< Playouts through this node, plus pending virtual losses
+        atomic<uint32_t> score;       ///< Twice the sum of results for the mover (2 win, 1 draw)
+        uint8_t move;                 ///< Move leading here, sub * 9 + cell
+        uint8_t n_children;           ///< Number of children once expanded
+    };
+
+    static const int32_t LEAF = -1;       ///< first_child of a node without children
+    static const int32_t EXPANDING = -2;  ///< first_child while a thread creates the children
+
+    Ultimate_TTT_MCTS_Config config;     ///< Search budget and tuning
+    Ultimate_TTT_Search_Stats stats;     ///< Statistics of the last search
+    unique_ptr<Node[]> nodes;            ///< Node arena
+    int capacity;                        ///< Number of nodes the arena holds
+    atomic<int> node_count;              ///< Nodes handed out from the arena
+    uint64_t seed;                       ///< Seed mixed into every worker's generator
+    uint64_t searches;                   ///< Searches run, so every search draws fresh numbers
+    vector<unique_ptr<Ultimate_TTT_MCTS>> helpers;  ///< Private trees for root parallelism
+
+    // Shared by the workers of one search
+    atomic<long long> playouts_started;  ///< Playouts claimed from the budget
+    atomic<long long> playouts_done;     ///< Playouts finished
+    atomic<bool> stop;                   ///< Set when the time limit is reached
+
+    /** @brief Advance a xorshift64* state and return 32 random bits */
+    static uint32_t next_random(uint64_t& state);
+
+    /** @brief Reset the arena to a single root node and expand it */
+    void reset_tree(const Ultimate_TTT_Bitboard& root);
+
+    /**
+     * @brief Create the children of a node for every legal move of pos
+     * @return False if another thread is expanding it or the arena is full
+     */
+    bool expand(int node, const Ultimate_TTT_Bitboard& pos);
+
+    /** @brief Pick the child with the highest UCT score */
+    int select_child(int node) const;
+
+    /**
+     * @brief Play random moves until the game ends
+     * @param pos Starting position (copied)
+     * @param rng Generator state of the calling worker
+     * @return Result for side 0: 2 win, 1 draw, 0 loss
+     */
+    static uint32_t playout(Ultimate_TTT_Bitboard pos, uint64_t& rng);
+
+    /**
+     * @brief Run playouts on the shared tree until the budget runs out
+     * @param root Position at the root of the tree
+     * @param rng_seed Seed for this worker's generator
+     * @param start Time the search started
+     * @param virtual_loss Visits charged to a path while its playout runs
+     */
+    void run_worker(const Ultimate_TTT_Bitboard& root, uint64_t rng_seed,
+                    chrono::steady_clock::time_point start, uint32_t virtual_loss);
+
+    /** @brief Run the tree-parallel search, workers on config.threads threads */
+    void search_tree(const Ultimate_TTT_Bitboard& root, chrono::steady_clock::time_point start);
+
+    /**
+     * @brief Run independent searches on helper trees and sum their root children
+     * @param visits Output visits per move (sub * 9 + cell)
+     * @param score Output score per move
+     */
+    void search_root_parallel(const Ultimate_TTT_Bitboard& root,
+                              uint64_t visits[81], uint64_t score[81]);
+};
+
+/**
+ * @brief Search limits for the Ultimate Tic Tac Toe alpha-beta player
+ */
+struct Ultimate_TTT_AlphaBeta_Config {
+    int max_depth = 8;       ///< Deepest iterative-deepening iteration
+    int time_limit_ms = 0;   ///< Abort the current iteration after this many milliseconds (0 = none)
+    int tt_bits = 20;        ///< Transposition table holds 2^tt_bits entries
+};
+
+/**
+ * @brief Statistics of the last alpha-beta search
+ */
+struct Ultimate_TTT_AlphaBeta_Stats {
+    long long nodes = 0;  ///< Positions visited
+    double seconds = 0;   ///< Wall-clock time spent searching
+    int depth = 0;        ///< Deepest completed iteration
+    int score = 0;        ///< Score of the chosen move for the player to move
+
+    /** @brief Search speed of the last search */
+    double nodes_per_second() const { return seconds > 0 ? nodes / seconds : 0; }
+};
+
+/**
+ * @brief Deterministic alpha-beta engine for Ultimate Tic Tac Toe
+ *
+ * Negamax with alpha-beta pruning, iterative deepening and a Zobrist-keyed
+ * transposition table. Leaves are scored by a static evaluator that adds
+ * the threat score of every open sub-board, taken from a table precomputed
+ * over all 3^9 sub-board states, to the line potential of the main board.
+ * The table is cleared before each search, so without a time limit the
+ * chosen move depends only on the position.
+ */
+class Ultimate_TTT_AlphaBeta {
+public:
+    /**
+     * @brief Construct an engine
+     * @param config Search limits
+     */
+    explicit Ultimate_TTT_AlphaBeta(const Ultimate_TTT_AlphaBeta_Config& config = Ultimate_TTT_AlphaBeta_Config());
+
+    /**
+     * @brief Search a position and pick a move for the player to move
+     * @param root Position to search
+     * @return Best move encoded as sub * 9 + cell, or -1 if the game is over
+     */
+    int search(const Ultimate_TTT_Bitboard& root);
+
+    /**
+     * @brief Static evaluation of a position
+     * @param pos Position to score
+     * @return Score for the player to move (positive is good)
+     */
+    static int evaluate(const Ultimate_TTT_Bitboard& pos);
+
+    /** @brief Statistics of the last search */
+    const Ultimate_TTT_AlphaBeta_Stats& get_stats() const { return stats; }
+
+    /** @brief Search limits, editable between searches */
+    Ultimate_TTT_AlphaBeta_Config& get_config() { return config; }
+
+private:
+    /** @brief Transposition table entry */
+    struct TT_Entry {
+        uint64_t key;    ///< Full Zobrist key of the position
+        int32_t score;   ///< Score, mate scores stored relative to the node
+        int8_t depth;    ///< Remaining depth the score was searched to
+        uint8_t flag;    ///< EXACT, LOWER or UPPER bound
+        uint8_t move;    ///< Best move found, sub * 9 + cell
+    };
+
+    Ultimate_TTT_AlphaBeta_Config config;  ///< Search limits
+    Ultimate_TTT_AlphaBeta_Stats stats;    ///< Statistics of the last search
+    vector<TT_Entry> table;                ///< Transposition table
+    chrono::steady_clock::time_point start;  ///< Start of the current search
+    bool aborted;                          ///< Set when the time limit cut an iteration short
+
+    /** @brief Zobrist key of a position computed from scratch */
+    static uint64_t hash_position(const Ultimate_TTT_Bitboard& pos);
+
+    /**
+     * @brief Zobrist key after a move
+     * @param hash Key before the move
+     * @param before Position before the move
+     * @param after Position after the move
+     * @param move The move played, sub * 9 + cell
+     */
+    static uint64_t hash_after(uint64_t hash, const Ultimate_TTT_Bitboard& before,
+                               const Ultimate_TTT_Bitboard& after, int move);
+
+    /**
+     * @brief Negamax search with alpha-beta pruning
+     * @param pos Position to search
+     * @param hash Zobrist key of pos
+     * @param depth Remaining depth
+     * @param ply Distance from the root
+     * @param alpha Lower bound for the player to move
+     * @param beta Upper bound for the player to move
+     * @return Score for the player to move
+     */
+    int negamax(const Ultimate_TTT_Bitboard& pos, uint64_t hash, int depth, int ply,
+                int alpha, int beta);
+};
+
 /**
  * @brief Board class for Ultimate Tic Tac Toe game
  *
@@ -27,36 +399,23 @@ template <typename T> class Ultimate_TTT_Random_Player;
 template <typename T>
 class Ultimate_TTT_Board : public Board<T> {
 private:
-    vector<vector<vector<T>>> sub_boards;  ///< 3x3 grid of 3x3 sub-boards
-    vector<vector<T>> main_board;          ///< 3x3 main board showing winners
-    vector<vector<bool>> sub_board_won;    ///< Track which sub-boards are won
-    int active_sub_board_x;                ///< Current active sub-board row
-    int active_sub_board_y;                ///< Current active sub-board column
-    bool first_move;                       ///< Flag for first move of game
+    Ultimate_TTT_Bitboard state;  ///< Bitboard layout of sub-boards and main board
+    T side_symbols[2];            ///< Symbol played by each bitboard side
+    int n_sides;                  ///< Number of symbols seen so far
 
     /**
-     * @brief Check if a 3x3 grid has three in a row
-     * @param grid The 3x3 grid to check
-     * @param symbol The player symbol to check for
-     * @return true if player has won this grid
-     */
-    bool check_win_in_grid(const vector<vector<T>>& grid, T symbol);
-
-    /**
-     * @brief Check if a sub-board is full
-     * @param sub_x Sub-board row index
-     * @param sub_y Sub-board column index
-     * @return true if sub-board is completely filled
+     * @brief Map a player symbol to its bitboard side
+     * @param symbol The player symbol
+     * @return Side index (0 or 1); unseen symbols are given the next free side
      */
-    bool is_sub_board_full(int sub_x, int sub_y);
+    int side_of(T symbol);
 
     /**
-     * @brief Update main board if sub-board is won
-     * @param sub_x Sub-board row index
-     * @param sub_y Sub-board column index
+     * @brief Look up the bitboard side of a symbol without assigning one
      * @param symbol The player symbol
+     * @return Side index, or -1 if the symbol has not played yet
      */
-    void update_main_board_if_won(int sub_x, int sub_y, T symbol);
+    int find_side(T symbol) const;
 
 public:
     /**
@@ -119,6 +478,34 @@ public:
      * @return 3x3 vector showing winners of each sub-board
      */
     vector<vector<T>> get_main_board() const;
+
+    /**
+     * @brief Count the legal moves for the next player
+     * @return Number of empty cells in playable sub-boards
+     * @details Respects the active sub-board and skips won and full
+     *          sub-boards; zero only when the game is over.
+     */
+    int count_legal_moves() const;
+
+    /**
+     * @brief Get one legal move by index in constant time
+     * @param n Index of the move, 0 <= n < count_legal_moves()
+     * @param x Reference to store the board row (0-8)
+     * @param y Reference to store the board column (0-8)
+     */
+    void get_legal_move(int n, int& x, int& y) const;
+
+    /**
+     * @brief List every legal move for the next player
+     * @return Board (row, column) pairs of all legal moves
+     */
+    vector<pair<int, int>> get_legal_moves() const;
+
+    /**
+     * @brief Get the bitboard layout of the current position
+     * @return Reference to the internal bitboard state
+     */
+    const Ultimate_TTT_Bitboard& get_bitboard() const { return state; }
 };
 
 /**
@@ -149,6 +536,21 @@ public:
      * @return Move object with position and symbol
      */
     Move<T>* get_move(Player<T>* player) override;
+
+    /**
+     * @brief Set up players, offering human, random and MCTS players
+     * @return Array of two Player pointers
+     */
+    Player<T>** setup_players() override;
+
+    /**
+     * @brief Create a player object for the chosen type
+     * @param name Player name
+     * @param symbol Player symbol (X or O)
+     * @param type HUMAN, COMPUTER (random) or AI (MCTS)
+     * @return Pointer to the new player
+     */
+    Player<T>* create_player(string& name, T symbol, PlayerType type) override;
 };
 
 /**
@@ -169,4 +571,70 @@ public:
     Ultimate_TTT_Random_Player(T symbol);
 };
 
+/**
+ * @brief Monte Carlo Tree Search computer player for Ultimate Tic Tac Toe
+ *
+ * Searches the board's bitboard with Ultimate_TTT_MCTS under a playout
+ * and time budget and reports its playout throughput after every move.
+ *
+ * @tparam T The type of symbol used (typically char)
+ */
+template <typename T>
+class Ultimate_TTT_MCTS_Player : public Player<T> {
+private:
+    Ultimate_TTT_MCTS engine;  ///< Search engine, reused across moves
+
+public:
+    /**
+     * @brief Constructor for MCTS player
+     * @param name Player name
+     * @param symbol Player symbol (X or O)
+     * @param config Search budget and tuning
+     */
+    Ultimate_TTT_MCTS_Player(string name, T symbol,
+                             const Ultimate_TTT_MCTS_Config& config = Ultimate_TTT_MCTS_Config());
+
+    /**
+     * @brief Search the current position and return the chosen move
+     * @return Move object with position and symbol
+     */
+    Move<T>* get_move();
+
+    /** @brief Statistics of the last search */
+    const Ultimate_TTT_Search_Stats& get_stats() const { return engine.get_stats(); }
+};
+
+/**
+ * @brief Alpha-beta computer player for Ultimate Tic Tac Toe
+ *
+ * Searches the board's bitboard with Ultimate_TTT_AlphaBeta. With the
+ * default depth limit and no time limit its play is fully reproducible.
+ *
+ * @tparam T The type of symbol used (typically char)
+ */
+template <typename T>
+class Ultimate_TTT_AlphaBeta_Player : public Player<T> {
+private:
+    Ultimate_TTT_AlphaBeta engine;  ///< Search engine, reused across moves
+
+public:
+    /**
+     * @brief Constructor for alpha-beta player
+     * @param name Player name
+     * @param symbol Player symbol (X or O)
+     * @param config Search limits
+     */
+    Ultimate_TTT_AlphaBeta_Player(string name, T symbol,
+                                  const Ultimate_TTT_AlphaBeta_Config& config = Ultimate_TTT_AlphaBeta_Config());
+
+    /**
+     * @brief Search the current position and return the chosen move
+     * @return Move object with position and symbol
+     */
+    Move<T>* get_move();
+
+    /** @brief Statistics of the last search */
+    const Ultimate_TTT_AlphaBeta_Stats& get_stats() const { return engine.get_stats(); }
+};
+
 #endif
\ No newline at end of file
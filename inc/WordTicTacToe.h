@@ -66,7 +66,7 @@ public:
     /**
      * @brief Constructor - Creates a 3x3 empty board
      * @details Initializes board dimensions to 3x3, sets all cells to '.',
-     *          loads dictionary from file, and seeds random generator
+     *          and loads dictionary from file
      * @throws runtime_error If dictionary loading fails
      */
     WordTicTacToe_Board();
@@ -184,7 +184,7 @@ public:
      * @return Pointer to Move object with random empty position and random letter (A-Z)
      * @throws runtime_error If no empty cells are available on the board
      * @details Scans board for empty cells, randomly selects one, and assigns random letter
-     * @note Uses rand() for randomization - ensure srand() is called during initialization
+     * @note Draws from the thread's game_random() generator
      */
     Move<char>* get_random_move();
 };
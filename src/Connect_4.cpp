@@ -2,6 +2,23 @@
 #include <iomanip>
 #include <cctype>
 #include "Connect_4.h"
+#include "Game_Random.h"
+#include <algorithm>
+#include <cstring>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define CONNECT_4_AVX2_KERNEL 1
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
@@ -19,48 +36,28 @@ bool Connect_4::update_board(Move<char>* move) {
     
     if (y < 0 || y >= columns) return false;
     
-    for (int x = rows - 1; x >= 0; x--) {
-        if (board[x][y] == blank_symbol) {
-            board[x][y] = toupper(mark);
-            a = x;
-            b = y;
-            n_moves++;
-            return true;
-        }
-    }
-    return false;
+    if (!position.can_play(y)) return false;
+
+    if (n_moves == 0) first_symbol = toupper(mark);
+
+    int x = rows - 1 - popcount(position.mask & Connect_4_Position::column_mask(y));
+    board[x][y] = toupper(mark);
+    position.play(y);
+    a = x;
+    b = y;
+    n_moves++;
+    return true;
 }
 
 bool Connect_4::is_win(Player<char>* player) {
-    const char sym = player->get_symbol();
-    
     if (a < 0 || b < 0) return false;
-    
-    auto check_four = [&](int dx, int dy) {
-        int count = 1;
-        
-        for (int i = 1; i < 4; i++) {
-            int nx = a + i * dx;
-            int ny = b + i * dy;
-            if (nx >= 0 && nx < rows && ny >= 0 && ny < columns && board[nx][ny] == sym)
-                count++;
-            else
-                break;
-        }
-        
-        for (int i = 1; i < 4; i++) {
-            int nx = a - i * dx;
-            int ny = b - i * dy;
-            if (nx >= 0 && nx < rows && ny >= 0 && ny < columns && board[nx][ny] == sym)
-                count++;
-            else
-                break;
-        }
-        
-        return count >= 4;
-    };
-    
-    return check_four(0, 1) || check_four(1, 0) || check_four(1, 1) || check_four(1, -1);
+
+    // The first mover's stones are `current` whenever an even number of moves was made
+    bool first = toupper(player->get_symbol()) == first_symbol;
+    bool first_to_move = position.moves % 2 == 0;
+    uint64_t stones = (first == first_to_move) ? position.current
+                                               : position.current ^ position.mask;
+    return Connect_4_Position::has_four(stones);
 }
 
 bool Connect_4::is_draw(Player<char>* player) {
@@ -79,18 +76,22 @@ Connect_4_UI::Connect_4_UI() : UI<char>("Welcome to FCAI Connect 4 Game", 2) {
     cout << "- Win: Get 4 of your marks in a row (horizontal, vertical, or diagonal)\n";
     cout << "- Draw: Board is full with no winner\n";
     cout << "================================\n\n";
+    player_type_options = { "Human", "Random Computer", "Perfect AI (Solver)" };
 }
 
 Player<char>* Connect_4_UI::create_player(string& name, char symbol, PlayerType type) {
     cout << "Creating " << (type == PlayerType::HUMAN ? "human" : "computer")
          << " player: " << name << " (" << symbol << ")\n";
     
+    if (type == PlayerType::AI)
+        return new Connect_4_AI_Player(name, symbol);
     return new Player<char>(name, symbol, type);
 }
 
 Move<char>* Connect_4_UI::get_move(Player<char>* player) {
-    int y;
-    Board<char>* boardPtr = player->get_board_ptr();
+    int y = -1;
+    Connect_4* boardPtr = dynamic_cast<Connect_4*>(player->get_board_ptr());
+    const Connect_4_Position& pos = boardPtr->get_position();
     
     if (player->get_type() == PlayerType::HUMAN) {
         cout << "\n" << player->get_name() << " (" << player->get_symbol() << ")'s turn\n";
@@ -98,23 +99,603 @@ Move<char>* Connect_4_UI::get_move(Player<char>* player) {
         cin >> y;
     }
     else if (player->get_type() == PlayerType::COMPUTER) {
-        y = rand() % boardPtr->get_columns();
+        int open_columns[Connect_4_Position::WIDTH];
+        int count = 0;
+        for (int col = 0; col < Connect_4_Position::WIDTH; col++)
+            if (pos.can_play(col))
+                open_columns[count++] = col;
+        if (count > 0)
+            y = open_columns[game_random().below(count)];
         cout << player->get_name() << " chooses column " << y << "\n";
     }
-    
-    int landing_row = -1;
-    auto matrix = boardPtr->get_board_matrix();
-    for (int x = boardPtr->get_rows() - 1; x >= 0; x--) {
-        if (matrix[x][y] == '.') {
-            landing_row = x;
-            break;
-        }
+    else if (player->get_type() == PlayerType::AI) {
+        Connect_4_AI_Player* ai = dynamic_cast<Connect_4_AI_Player*>(player);
+        int score = 0;
+        y = ai->choose_column(score);
+        const Connect_4_Solver& solver = ai->get_solver();
+        cout << player->get_name() << " chooses column " << y;
+        if (solver.used_book())
+            cout << " (score " << score << ", opening book)\n";
+        else if (solver.timed_out())
+            cout << " (heuristic, solver ran out of time)\n";
+        else
+            cout << " (score " << score << ", " << solver.get_node_count() << " positions)\n";
     }
     
-    if (landing_row != -1) {
+    if (y >= 0 && y < Connect_4_Position::WIDTH && pos.can_play(y)) {
+        int landing_row = boardPtr->get_rows() - 1 -
+                          popcount(pos.mask & Connect_4_Position::column_mask(y));
         cout << player->get_name() << " placed " << player->get_symbol() 
              << " at position (" << landing_row << ", " << y << ")\n";
     }
     
     return new Move<char>(0, y, player->get_symbol());
-}
\ No newline at end of file
+}
+
+Connect_4_Book::~Connect_4_Book() {
+    close();
+}
+
+bool Connect_4_Book::open(const string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart < (LONGLONG)sizeof(Header)) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    file_handle = file;
+    mapping_handle = mapping;
+    data = view;
+    length = size_t(file_size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(Header)) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) return false;
+    data = view;
+    length = size_t(st.st_size);
+#endif
+
+    Header header;
+    memcpy(&header, data, sizeof(Header));
+    uint64_t entries = header.count;
+    bool valid = memcmp(header.magic, "C4BK", 4) == 0 && header.version == VERSION &&
+                 entries <= (length - sizeof(Header)) / (sizeof(uint64_t) + sizeof(int8_t)) &&
+                 length == sizeof(Header) + entries * (sizeof(uint64_t) + sizeof(int8_t));
+    if (!valid) {
+        close();
+        return false;
+    }
+
+    const char* base = static_cast<const char*>(data);
+    keys = reinterpret_cast<const uint64_t*>(base + sizeof(Header));
+    scores = reinterpret_cast<const int8_t*>(base + sizeof(Header) + entries * sizeof(uint64_t));
+    count = size_t(entries);
+    depth = int(header.depth);
+    return true;
+}
+
+void Connect_4_Book::close() {
+    if (data) {
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+        CloseHandle(mapping_handle);
+        CloseHandle(file_handle);
+        mapping_handle = nullptr;
+        file_handle = nullptr;
+#else
+        munmap(data, length);
+#endif
+    }
+    data = nullptr;
+    length = 0;
+    keys = nullptr;
+    scores = nullptr;
+    count = 0;
+    depth = 0;
+}
+
+bool Connect_4_Book::probe(const Connect_4_Position& pos, int& score) const {
+    if (!keys || pos.moves > depth) return false;
+    uint64_t key = pos.canonical_key();
+    const uint64_t* it = lower_bound(keys, keys + count, key);
+    if (it == keys + count || *it != key) return false;
+    score = scores[it - keys];
+    return true;
+}
+
+Connect_4_Solver::Connect_4_Solver(int time_limit_ms) : time_limit_ms(time_limit_ms) {}
+
+uint8_t Connect_4_Solver::table_get(uint64_t key) const {
+    size_t slot = key % TABLE_SIZE;
+    return table_keys[slot] == uint32_t(key) ? table_values[slot] : 0;
+}
+
+void Connect_4_Solver::table_put(uint64_t key, uint8_t value) {
+    size_t slot = key % TABLE_SIZE;
+    table_keys[slot] = uint32_t(key);
+    table_values[slot] = value;
+}
+
+int Connect_4_Solver::negamax(const Connect_4_Position& pos, int alpha, int beta) {
+    const int cells = Connect_4_Position::WIDTH * Connect_4_Position::HEIGHT;
+
+    nodes++;
+    if (aborted || ((nodes & 4095) == 0 && time_limit_ms > 0 &&
+                    chrono::steady_clock::now() >= deadline)) {
+        aborted = true;
+        return 0;
+    }
+
+    uint64_t next = pos.possible_non_losing_moves();
+    if (next == 0)
+        return -(cells - pos.moves) / 2;
+    if (pos.moves >= cells - 2)
+        return 0;
+
+    // The opponent cannot win next move, so the score is at least this
+    int min = -(cells - 2 - pos.moves) / 2;
+    if (alpha < min) {
+        alpha = min;
+        if (alpha >= beta) return alpha;
+    }
+
+    // We cannot win next move either, so the score is at most this
+    int max = (cells - 1 - pos.moves) / 2;
+    if (beta > max) {
+        beta = max;
+        if (alpha >= beta) return beta;
+    }
+
+    uint64_t key = pos.key();
+    if (int value = table_get(key)) {
+        if (value > MAX_SCORE - MIN_SCORE + 1) {
+            min = value + 2 * MIN_SCORE - MAX_SCORE - 2;
+            if (alpha < min) {
+                alpha = min;
+                if (alpha >= beta) return alpha;
+            }
+        } else {
+            max = value + MIN_SCORE - 1;
+            if (beta > max) {
+                beta = max;
+                if (alpha >= beta) return beta;
+            }
+        }
+    }
+
+    // Sort moves by threats created; insertion is stable and columns are
+    // added outside-in so ties keep the center-first order.
+    uint64_t moves[Connect_4_Position::WIDTH];
+    int scores[Connect_4_Position::WIDTH];
+    int count = 0;
+    for (int i = Connect_4_Position::WIDTH - 1; i >= 0; i--) {
+        uint64_t move = next & Connect_4_Position::column_mask(column_order(i));
+        if (!move) continue;
+        int score = pos.move_score(move);
+        int j = count++;
+        for (; j > 0 && scores[j - 1] > score; j--) {
+            moves[j] = moves[j - 1];
+            scores[j] = scores[j - 1];
+        }
+        moves[j] = move;
+        scores[j] = score;
+    }
+
+    for (int i = count - 1; i >= 0; i--) {
+        Connect_4_Position child = pos;
+        child.play_move(moves[i]);
+        int score = -negamax(child, -beta, -alpha);
+        if (aborted) return 0;
+
+        if (score >= beta) {
+            table_put(key, uint8_t(score + MAX_SCORE - 2 * MIN_SCORE + 2));
+            return score;
+        }
+        if (score > alpha) alpha = score;
+    }
+
+    table_put(key, uint8_t(alpha - MIN_SCORE + 1));
+    return alpha;
+}
+
+int Connect_4_Solver::solve(const Connect_4_Position& pos, bool weak) {
+    const int cells = Connect_4_Position::WIDTH * Connect_4_Position::HEIGHT;
+
+    if (table_keys.empty()) {
+        table_keys.assign(TABLE_SIZE, 0);
+        table_values.assign(TABLE_SIZE, 0);
+    }
+
+    if (pos.can_win_next())
+        return (cells + 1 - pos.moves) / 2;
+
+    int min = -(cells - pos.moves) / 2;
+    int max = (cells + 1 - pos.moves) / 2;
+    if (weak) {
+        min = -1;
+        max = 1;
+    }
+
+    // Bisect the score with null-window searches, probing near 0 first
+    while (min < max && !aborted) {
+        int med = min + (max - min) / 2;
+        if (med <= 0 && min / 2 < med) med = min / 2;
+        else if (med >= 0 && max / 2 > med) med = max / 2;
+        int r = negamax(pos, med, med + 1);
+        if (r <= med) max = r;
+        else min = r;
+    }
+    return min;
+}
+
+int Connect_4_Solver::heuristic_move(const Connect_4_Position& pos) const {
+    uint64_t candidates = pos.possible_non_losing_moves();
+    if (candidates == 0) candidates = pos.possible();
+
+    int best_col = -1;
+    int best_score = -1;
+    for (int i = 0; i < Connect_4_Position::WIDTH; i++) {
+        int col = column_order(i);
+        uint64_t move = candidates & Connect_4_Position::column_mask(col);
+        if (!move) continue;
+        int score = pos.move_score(move);
+        if (score > best_score) {
+            best_score = score;
+            best_col = col;
+        }
+    }
+    return best_col;
+}
+
+int Connect_4_Solver::best_move(const Connect_4_Position& pos, int& score) {
+    nodes = 0;
+    aborted = false;
+    from_book = false;
+    deadline = chrono::steady_clock::now() + chrono::milliseconds(time_limit_ms);
+
+    for (int i = 0; i < Connect_4_Position::WIDTH; i++) {
+        int col = column_order(i);
+        if (pos.can_play(col) && pos.is_winning_move(col)) {
+            score = (Connect_4_Position::WIDTH * Connect_4_Position::HEIGHT + 1 - pos.moves) / 2;
+            return col;
+        }
+    }
+
+    int best_col = book_move(pos, score);
+    if (best_col >= 0) {
+        from_book = true;
+        return best_col;
+    }
+
+    score = MIN_SCORE - 100;
+    for (int i = 0; i < Connect_4_Position::WIDTH; i++) {
+        int col = column_order(i);
+        if (!pos.can_play(col)) continue;
+
+        Connect_4_Position child = pos;
+        child.play(col);
+        int child_score = -solve(child);
+        if (aborted) break;
+        if (child_score > score) {
+            score = child_score;
+            best_col = col;
+        }
+    }
+
+    if (aborted) {
+        score = 0;
+        return heuristic_move(pos);
+    }
+    return best_col;
+}
+
+int Connect_4_Solver::book_move(const Connect_4_Position& pos, int& score) const {
+    if (!book || pos.moves >= book->get_depth()) return -1;
+
+    int best_col = -1;
+    score = MIN_SCORE - 100;
+    for (int i = 0; i < Connect_4_Position::WIDTH; i++) {
+        int col = column_order(i);
+        if (!pos.can_play(col)) continue;
+
+        Connect_4_Position child = pos;
+        child.play(col);
+        int child_score;
+        if (!book->probe(child, child_score)) return -1;
+        if (-child_score > score) {
+            score = -child_score;
+            best_col = col;
+        }
+    }
+    return best_col;
+}
+
+Connect_4_AI_Player::Connect_4_AI_Player(string name, char symbol)
+    : Player<char>(name, symbol, PlayerType::AI) {
+    // Same lookup as the dictionary files: run directory first, then the parent
+    for (const char* path : {"connect_4_book.bin", "../connect_4_book.bin"}) {
+        if (book.open(path)) {
+            solver.set_book(&book);
+            break;
+        }
+    }
+}
+
+int Connect_4_AI_Player::choose_column(int& score) {
+    Connect_4* board = dynamic_cast<Connect_4*>(boardPtr);
+    return solver.best_move(board->get_position(), score);
+}
+
+/** @brief Advance a xorshift64 state */
+static inline uint64_t next_random(uint64_t& x) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return x;
+}
+
+/** @brief Plays `count` random games one after another; results[0..2] are wins, draws, losses */
+static void playouts_scalar(const Connect_4_Position& start, uint64_t count, uint64_t& rng, uint64_t results[3]) {
+    for (uint64_t game = 0; game < count; game++) {
+        uint64_t current = start.current;
+        uint64_t mask = start.mask;
+        int side = 0;
+        for (;;) {
+            uint64_t possible = (mask + Connect_4_Position::BOTTOM) & Connect_4_Position::BOARD;
+            uint64_t move;
+            do {
+                int col = int(((next_random(rng) >> 32) * Connect_4_Position::WIDTH) >> 32);
+                move = possible & Connect_4_Position::column_mask(col);
+            } while (!move);
+
+            current ^= mask;
+            mask |= move;
+            if (Connect_4_Position::has_four(current ^ mask)) {
+                results[side == 0 ? 0 : 2]++;
+                break;
+            }
+            if (mask == Connect_4_Position::BOARD) {
+                results[1]++;
+                break;
+            }
+            side ^= 1;
+        }
+    }
+}
+
+#ifdef CONNECT_4_AVX2_KERNEL
+#define CONNECT_4_AVX2 __attribute__((target("avx2")))
+
+/** @brief Lanes of `stones` holding four in a row are non-zero */
+CONNECT_4_AVX2 static inline __m256i four_in_a_row_avx2(__m256i stones) {
+    const int H = Connect_4_Position::HEIGHT;
+    __m256i m = _mm256_and_si256(stones, _mm256_srli_epi64(stones, H + 1));
+    __m256i r = _mm256_and_si256(m, _mm256_srli_epi64(m, 2 * (H + 1)));
+    m = _mm256_and_si256(stones, _mm256_srli_epi64(stones, H));
+    r = _mm256_or_si256(r, _mm256_and_si256(m, _mm256_srli_epi64(m, 2 * H)));
+    m = _mm256_and_si256(stones, _mm256_srli_epi64(stones, H + 2));
+    r = _mm256_or_si256(r, _mm256_and_si256(m, _mm256_srli_epi64(m, 2 * (H + 2))));
+    m = _mm256_and_si256(stones, _mm256_srli_epi64(stones, 1));
+    return _mm256_or_si256(r, _mm256_and_si256(m, _mm256_srli_epi64(m, 2)));
+}
+
+/**
+ * @brief Plays one random move in every active lane
+ * @param won Receives the lanes whose move made four in a row
+ * @return Lanes whose game ended with that move
+ */
+CONNECT_4_AVX2 static inline __m256i step_avx2(__m256i& current, __m256i& mask, __m256i& rng,
+                                               __m256i active, __m256i& won) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i board = _mm256_set1_epi64x(int64_t(Connect_4_Position::BOARD));
+    const __m256i width = _mm256_set1_epi64x(Connect_4_Position::WIDTH);
+    const __m256i column = _mm256_set1_epi64x(int64_t(Connect_4_Position::column_mask(0)));
+
+    __m256i possible = _mm256_and_si256(
+        _mm256_add_epi64(mask, _mm256_set1_epi64x(int64_t(Connect_4_Position::BOTTOM))), board);
+    __m256i move = zero;
+    __m256i need = active;
+    do {
+        rng = _mm256_xor_si256(rng, _mm256_slli_epi64(rng, 13));
+        rng = _mm256_xor_si256(rng, _mm256_srli_epi64(rng, 7));
+        rng = _mm256_xor_si256(rng, _mm256_slli_epi64(rng, 17));
+        __m256i col = _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(rng, 32), width), 32);
+        __m256i shift = _mm256_sub_epi64(_mm256_slli_epi64(col, 3), col);
+        __m256i candidate = _mm256_and_si256(possible, _mm256_sllv_epi64(column, shift));
+        __m256i take = _mm256_andnot_si256(_mm256_cmpeq_epi64(candidate, zero), need);
+        move = _mm256_or_si256(move, _mm256_and_si256(candidate, take));
+        need = _mm256_andnot_si256(take, need);
+    } while (!_mm256_testz_si256(need, need));
+
+    current = _mm256_xor_si256(current, mask);
+    mask = _mm256_or_si256(mask, move);
+    won = _mm256_andnot_si256(
+        _mm256_cmpeq_epi64(four_in_a_row_avx2(_mm256_xor_si256(current, mask)), zero), active);
+    __m256i full = _mm256_and_si256(_mm256_cmpeq_epi64(mask, board), active);
+    return _mm256_or_si256(won, full);
+}
+
+/** @brief Sum of the four 64-bit lanes */
+CONNECT_4_AVX2 static inline uint64_t horizontal_sum(__m256i v) {
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), v);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+/**
+ * @brief Plays `count` random games, Connect_4_Playout_Kernel::LANES at a time
+ * @details While more games remain than lanes finish, finished lanes are
+ *          scored and restarted with vector blends; only the last few games
+ *          go through the per-lane bookkeeping that retires lanes.
+ */
+CONNECT_4_AVX2 static void playouts_avx2(const Connect_4_Position& start, uint64_t count,
+                                         uint64_t* rng, uint64_t results[3]) {
+    const int LANES = Connect_4_Playout_Kernel::LANES;
+    const int VECTORS = LANES / 4;
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    const __m256i start_current = _mm256_set1_epi64x(int64_t(start.current));
+    const __m256i start_mask = _mm256_set1_epi64x(int64_t(start.mask));
+    alignas(32) uint64_t current[LANES], mask[LANES], active[LANES], starter[LANES];
+
+    uint64_t started = 0;
+    for (int lane = 0; lane < LANES; lane++) {
+        active[lane] = started < count ? ~0ull : 0;
+        if (active[lane]) started++;
+    }
+
+    // starter: lanes where the player to move at the start makes the next move
+    __m256i cur[VECTORS], msk[VECTORS], live[VECTORS], gen[VECTORS], first[VECTORS];
+    __m256i wins = _mm256_setzero_si256(), draws = wins, losses = wins;
+    for (int v = 0; v < VECTORS; v++) {
+        cur[v] = start_current;
+        msk[v] = start_mask;
+        live[v] = _mm256_load_si256(reinterpret_cast<const __m256i*>(active + 4 * v));
+        gen[v] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rng + 4 * v));
+        first[v] = ones;
+    }
+
+    for (;;) {
+        __m256i done[VECTORS], won[VECTORS];
+        int finished = 0;
+        for (int v = 0; v < VECTORS; v++) {
+            done[v] = step_avx2(cur[v], msk[v], gen[v], live[v], won[v]);
+            finished += popcount(unsigned(_mm256_movemask_pd(_mm256_castsi256_pd(done[v]))));
+        }
+
+        if (started + finished <= count) {
+            // Every finished lane starts another game
+            for (int v = 0; v < VECTORS; v++) {
+                __m256i drawn = _mm256_andnot_si256(won[v], done[v]);
+                wins = _mm256_sub_epi64(wins, _mm256_and_si256(won[v], first[v]));
+                losses = _mm256_sub_epi64(losses, _mm256_andnot_si256(first[v], won[v]));
+                draws = _mm256_sub_epi64(draws, drawn);
+                cur[v] = _mm256_blendv_epi8(cur[v], start_current, done[v]);
+                msk[v] = _mm256_blendv_epi8(msk[v], start_mask, done[v]);
+                first[v] = _mm256_or_si256(_mm256_xor_si256(first[v], ones), done[v]);
+            }
+            started += finished;
+            continue;
+        }
+
+        // Tail: score lane by lane and retire lanes once every game has started
+        bool any_active = false;
+        for (int v = 0; v < VECTORS; v++) {
+            first[v] = _mm256_xor_si256(first[v], ones);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(current + 4 * v), cur[v]);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(mask + 4 * v), msk[v]);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(starter + 4 * v), first[v]);
+        }
+        for (int lane = 0; lane < LANES; lane++) {
+            if (!active[lane]) continue;
+            bool lane_won = Connect_4_Position::has_four(current[lane] ^ mask[lane]);
+            if (lane_won || mask[lane] == Connect_4_Position::BOARD) {
+                // starter is already flipped, so it is clear when the starter just moved
+                results[lane_won ? (starter[lane] ? 2 : 0) : 1]++;
+                current[lane] = start.current;
+                mask[lane] = start.mask;
+                starter[lane] = ~0ull;
+                if (started < count) started++;
+                else active[lane] = 0;
+            }
+            any_active |= active[lane] != 0;
+        }
+        if (!any_active) break;
+        for (int v = 0; v < VECTORS; v++) {
+            cur[v] = _mm256_load_si256(reinterpret_cast<const __m256i*>(current + 4 * v));
+            msk[v] = _mm256_load_si256(reinterpret_cast<const __m256i*>(mask + 4 * v));
+            live[v] = _mm256_load_si256(reinterpret_cast<const __m256i*>(active + 4 * v));
+            first[v] = _mm256_load_si256(reinterpret_cast<const __m256i*>(starter + 4 * v));
+        }
+    }
+
+    results[0] += horizontal_sum(wins);
+    results[1] += horizontal_sum(draws);
+    results[2] += horizontal_sum(losses);
+    for (int v = 0; v < VECTORS; v++)
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(rng + 4 * v), gen[v]);
+}
+#endif // CONNECT_4_AVX2_KERNEL
+
+Connect_4_Playout_Kernel::Connect_4_Playout_Kernel(uint64_t seed, Backend backend)
+    : backend(backend == Backend::AVX2 && best_backend() != Backend::AVX2 ? Backend::SCALAR : backend) {
+    // splitmix64 spreads one seed over the lanes; xorshift needs a non-zero state
+    for (int lane = 0; lane < LANES; lane++) {
+        uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        z ^= z >> 31;
+        rng[lane] = z ? z : 1;
+    }
+}
+
+Connect_4_Playout_Kernel::Backend Connect_4_Playout_Kernel::best_backend() {
+#ifdef CONNECT_4_AVX2_KERNEL
+    if (__builtin_cpu_supports("avx2")) return Backend::AVX2;
+#endif
+    return Backend::SCALAR;
+}
+
+const char* Connect_4_Playout_Kernel::backend_name(Backend backend) {
+    return backend == Backend::AVX2 ? "avx2" : "scalar";
+}
+
+void Connect_4_Playout_Kernel::run(const Connect_4_Position& start, uint64_t count,
+                                   uint64_t& wins, uint64_t& draws, uint64_t& losses) {
+    if (count == 0) return;
+
+    uint64_t results[3] = { 0, 0, 0 };
+    if (start.mask == Connect_4_Position::BOARD) {
+        results[1] = count;
+    }
+#ifdef CONNECT_4_AVX2_KERNEL
+    else if (backend == Backend::AVX2) {
+        playouts_avx2(start, count, rng, results);
+    }
+#endif
+    else {
+        playouts_scalar(start, count, rng[0], results);
+    }
+    wins += results[0];
+    draws += results[1];
+    losses += results[2];
+}
+
+Connect_4_Playout_Stats Connect_4_Playout_Kernel::evaluate_moves(const Connect_4_Position& root,
+                                                                 uint64_t playouts_per_move) {
+    Connect_4_Playout_Stats stats;
+    for (int col = 0; col < Connect_4_Position::WIDTH; col++) {
+        if (!root.can_play(col)) continue;
+        if (root.is_winning_move(col)) {
+            stats.wins[col] = playouts_per_move;
+            continue;
+        }
+        Connect_4_Position child = root;
+        child.play(col);
+        // The opponent moves first in the child, so its wins are our losses
+        run(child, playouts_per_move, stats.losses[col], stats.draws[col], stats.wins[col]);
+    }
+    return stats;
+}
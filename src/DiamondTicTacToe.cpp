@@ -1,124 +1,122 @@
 #include "DiamondTicTacToe.h"
-#include <iostream>
+#include <array>
+#include <bit>
 #include <cstdlib>
-#include <ctime>
+#include <iostream>
 
 using namespace std;
 
-DiamondBoard::DiamondBoard() : Board<char>(7, 7) {
-    initialize_diamond_shape();
+/// Diamond with 1, 3, 5, 7, 5, 3, 1 cells per row on a 7x7 grid
+static constexpr const char* DIAMOND_SHAPE[7] = {
+    "###.###",
+    "##...##",
+    "#.....#",
+    ".......",
+    "#.....#",
+    "##...##",
+    "###.###"
+};
+
+static constexpr Board_Geometry<7, 7> DIAMOND_GEOMETRY(DIAMOND_SHAPE);
+static constexpr auto DIAMOND_LINES_3 = DIAMOND_GEOMETRY.lines(3);
+static constexpr auto DIAMOND_LINES_4 = DIAMOND_GEOMETRY.lines(4);
 
+DiamondBoard::DiamondBoard() : Board<char>(7, 7) {
     for (int i = 0; i < 7; i++) {
         for (int j = 0; j < 7; j++) {
-            board[i][j] = diamond_shape[i][j] ? blank : '#';
+            board[i][j] = DIAMOND_GEOMETRY.playable(i, j) ? blank : '#';
         }
     }
-    srand(static_cast<unsigned>(time(0)));
 }
 
-void DiamondBoard::initialize_diamond_shape() {
-    for (int i = 0; i < 7; i++) {
-        for (int j = 0; j < 7; j++) {
-            diamond_shape[i][j] = false;
-        }
-    }
-
-    int cols_per_row[7] = {1, 3, 5, 7, 5, 3, 1};
+bool DiamondBoard::is_playable(int x, int y) const {
+    return DIAMOND_GEOMETRY.playable(x, y);
+}
 
-    for (int i = 0; i < 7; i++) {
-        int start = (7 - cols_per_row[i]) / 2;
-        for (int j = 0; j < cols_per_row[i]; j++) {
-            diamond_shape[i][start + j] = true;
-        }
-    }
+void DiamondBoard::set_cell(int cell, char symbol) {
+    int row = DIAMOND_GEOMETRY.row_of(cell);
+    int col = DIAMOND_GEOMETRY.col_of(cell);
+    if (board[row][col] != blank)
+        stones[side_of(board[row][col])] &= ~(1ull << cell);
+    if (symbol != blank)
+        stones[side_of(symbol)] |= 1ull << cell;
+    board[row][col] = symbol;
 }
 
 bool DiamondBoard::update_board(Move<char>* move) {
     int x = move->get_x();
     int y = move->get_y();
 
-    if (x < 0 || x >= 7 || y < 0 || y >= 7) return false;
-    if (!diamond_shape[x][y]) return false;
+    int cell = DIAMOND_GEOMETRY.index(x, y);
+    if (cell < 0) return false;
     if (board[x][y] != blank) return false;
 
-    board[x][y] = move->get_symbol();
+    set_cell(cell, move->get_symbol());
     n_moves++;
     return true;
 }
 
-vector<vector<pair<int,int>>> DiamondBoard::find_lines_of_length(char symbol, int length) {
-    vector<vector<pair<int,int>>> lines;
-    int directions[4][2] = {{0,1}, {1,0}, {1,1}, {1,-1}};
-
-    for (int i = 0; i < 7; i++) {
-        for (int j = 0; j < 7; j++) {
-            for (int d = 0; d < 4; d++) {
-                vector<pair<int,int>> line;
-                bool valid = true;
-
-                for (int k = 0; k < length; k++) {
-                    int row = i + k * directions[d][0];
-                    int col = j + k * directions[d][1];
-
-                    if (row < 0 || row >= 7 || col < 0 || col >= 7 ||
-                        !diamond_shape[row][col] || board[row][col] != symbol) {
-                        valid = false;
-                        break;
-                    }
-                    line.push_back({row, col});
-                }
-
-                if (valid) {
-                    lines.push_back(line);
-                }
-            }
+/// Dense cells from the center outwards, the order moves are tried in
+static constexpr array<uint8_t, 25> DIAMOND_MOVE_ORDER = [] {
+    array<uint8_t, 25> order{};
+    for (int i = 0; i < 25; i++) order[i] = uint8_t(i);
+    auto distance = [](int cell) {
+        return abs(DIAMOND_GEOMETRY.row_of(cell) - 3) + abs(DIAMOND_GEOMETRY.col_of(cell) - 3);
+    };
+    for (int i = 1; i < 25; i++)
+        for (int j = i; j > 0 && distance(order[j]) < distance(order[j - 1]); j--) {
+            uint8_t t = order[j]; order[j] = order[j - 1]; order[j - 1] = t;
         }
-    }
+    return order;
+}();
 
-    return lines;
-}
+/// Score of an open line holding n of one side's marks, for 3-lines and 4-lines
+static constexpr int DIAMOND_LINE_WEIGHT[2][5] = { { 0, 1, 4, 0, 0 }, { 0, 1, 3, 9, 0 } };
 
-bool DiamondBoard::lines_different_directions(const vector<pair<int,int>>& line1,
-                                              const vector<pair<int,int>>& line2) {
-    if (line1.size() < 2 || line2.size() < 2) return false;
+bool Diamond_Position::wins(uint64_t own) {
+    // Directions in which the player owns a full 3-line and a full 4-line
+    unsigned dirs_3 = 0;
+    for (int i = 0; i < DIAMOND_LINES_3.count; i++)
+        if ((own & DIAMOND_LINES_3[i]) == DIAMOND_LINES_3[i])
+            dirs_3 |= 1u << DIAMOND_LINES_3.directions[i];
+    if (dirs_3 == 0) return false;
 
-    int dx1 = line1[1].first - line1[0].first;
-    int dy1 = line1[1].second - line1[0].second;
-    int dx2 = line2[1].first - line2[0].first;
-    int dy2 = line2[1].second - line2[0].second;
+    unsigned dirs_4 = 0;
+    for (int i = 0; i < DIAMOND_LINES_4.count; i++)
+        if ((own & DIAMOND_LINES_4[i]) == DIAMOND_LINES_4[i])
+            dirs_4 |= 1u << DIAMOND_LINES_4.directions[i];
+    if (dirs_4 == 0) return false;
 
-    return !(dx1 == dx2 && dy1 == dy2);
+    // Some pair differs unless both sets are the same single direction
+    return !(dirs_3 == dirs_4 && (dirs_3 & (dirs_3 - 1)) == 0);
 }
 
-int DiamondBoard::count_shared_cells(const vector<pair<int,int>>& line1,
-                                     const vector<pair<int,int>>& line2) {
+int Diamond_Position::generate_moves(Move* moves) const {
+    uint64_t taken = stones[0] | stones[1];
     int count = 0;
-    for (const auto& cell1 : line1) {
-        for (const auto& cell2 : line2) {
-            if (cell1 == cell2) {
-                count++;
-            }
-        }
-    }
+    for (uint8_t cell : DIAMOND_MOVE_ORDER)
+        if (!(taken >> cell & 1)) moves[count++] = cell;
     return count;
 }
 
-bool DiamondBoard::check_win_for_symbol(char symbol) {
-    auto lines_3 = find_lines_of_length(symbol, 3);
-    auto lines_4 = find_lines_of_length(symbol, 4);
-
-    for (const auto& line3 : lines_3) {
-        for (const auto& line4 : lines_4) {
-            if (!lines_different_directions(line3, line4)) continue;
-
-            int shared = count_shared_cells(line3, line4);
-            if (shared <= 1) {
-                return true;
-            }
-        }
+int Diamond_Position::evaluate() const {
+    uint64_t mine = stones[side], theirs = stones[side ^ 1];
+    int score = 0;
+    for (int i = 0; i < DIAMOND_LINES_3.count; i++) {
+        uint64_t line = DIAMOND_LINES_3[i];
+        if (!(theirs & line)) score += DIAMOND_LINE_WEIGHT[0][popcount(mine & line)];
+        else if (!(mine & line)) score -= DIAMOND_LINE_WEIGHT[0][popcount(theirs & line)];
+    }
+    for (int i = 0; i < DIAMOND_LINES_4.count; i++) {
+        uint64_t line = DIAMOND_LINES_4[i];
+        if (!(theirs & line)) score += DIAMOND_LINE_WEIGHT[1][popcount(mine & line)];
+        else if (!(mine & line)) score -= DIAMOND_LINE_WEIGHT[1][popcount(theirs & line)];
     }
+    return score;
+}
 
-    return false;
+bool DiamondBoard::check_win_for_symbol(char symbol) {
+    return Diamond_Position::wins(stones[side_of(symbol)]);
 }
 
 bool DiamondBoard::is_win(Player<char>* player) {
@@ -130,83 +128,32 @@ bool DiamondBoard::is_lose(Player<char> *) {
 }
 
 bool DiamondBoard::is_draw(Player<char>* player) {
-    return n_moves >= 37;
+    return n_moves >= DIAMOND_GEOMETRY.size();
 }
 
 bool DiamondBoard::game_is_over(Player<char>* player) {
-    return is_win(player) || n_moves >= 37;
-}
-
-int DiamondBoard::minimax(char current_player, char ai_symbol, int depth, int max_depth, int alpha, int beta) {
-    char opponent_symbol = (ai_symbol == 'X') ? 'O' : 'X';
-
-    if (depth >= max_depth) return 0;
-    if (check_win_for_symbol(ai_symbol)) return 10 - depth;
-    if (check_win_for_symbol(opponent_symbol)) return -10 + depth;
-    if (n_moves >= 37) return 0;
-
-    bool is_maximizing = (current_player == ai_symbol);
-    int best_score = is_maximizing ? -1000000 : 1000000;
-
-    for (int i = 0; i < 7; i++) {
-        for (int j = 0; j < 7; j++) {
-            if (diamond_shape[i][j] && board[i][j] == blank) {
-                board[i][j] = current_player;
-                n_moves++;
-
-                char next_player = is_maximizing ? opponent_symbol : ai_symbol;
-                int score = minimax(next_player, ai_symbol, depth + 1, max_depth, alpha, beta);
-
-                board[i][j] = blank;
-                n_moves--;
-
-                if (is_maximizing) {
-                    best_score = max(best_score, score);
-                    alpha = max(alpha, score);
-                } else {
-                    best_score = min(best_score, score);
-                    beta = min(beta, score);
-                }
-
-                if (beta <= alpha) return best_score;
-            }
-        }
-    }
-    return best_score;
+    return is_win(player) || n_moves >= DIAMOND_GEOMETRY.size();
 }
 
 pair<int, int> DiamondBoard::get_best_move(char ai_symbol, int difficulty) {
-    char opponent_symbol = (ai_symbol == 'X') ? 'O' : 'X';
-    int best_score = -1000000;
-    pair<int, int> best_move = {-1, -1};
-    int alpha = -1000000;
-    int beta = 1000000;
+    Diamond_Position root;
+    root.stones[0] = stones[0];
+    root.stones[1] = stones[1];
+    root.side = side_of(ai_symbol);
+    root.n_moves = popcount(stones[0] | stones[1]);
 
     cout << "AI is thinking with (difficulty: " << difficulty << ")...\n";
 
-    for (int i = 0; i < 7; i++) {
-        for (int j = 0; j < 7; j++) {
-            if (diamond_shape[i][j] && board[i][j] == blank) {
-                board[i][j] = ai_symbol;
-                n_moves++;
-
-                int score = minimax(opponent_symbol, ai_symbol, 0, difficulty, alpha, beta);
-
-                board[i][j] = blank;
-                n_moves--;
-
-                if (score > best_score) {
-                    best_score = score;
-                    best_move = {i, j};
-                }
-
-                alpha = max(alpha, best_score);
-            }
-        }
-    }
+    Search_Config config;
+    config.max_depth = difficulty + 1;
+    config.time_limit_ms = 3000;
+    Search<Diamond_Position> engine(config);
+    int cell = engine.search(root);
+    if (cell < 0) return {-1, -1};
 
+    pair<int, int> best_move = {DIAMOND_GEOMETRY.row_of(cell), DIAMOND_GEOMETRY.col_of(cell)};
     cout << "AI chooses (" << best_move.first << ", " << best_move.second
-         << ") with score: " << best_score << "\n";
+         << ") with score: " << engine.get_stats().score << "\n";
 
     return best_move;
 }
@@ -216,7 +163,7 @@ DiamondPlayer::DiamondPlayer(string n, char s, PlayerType t)
 
 Move<char>* DiamondPlayer::get_move() {
     DiamondBoard* db = static_cast<DiamondBoard*>(this->boardPtr);
-    auto [row, col] = db->get_best_move(symbol, 5);
+    auto [row, col] = db->get_best_move(symbol, 7);
     cout << name << " places '" << symbol << "' at (" << row << ", " << col << ")\n";
     return new Move<char>(row, col, symbol);
 }
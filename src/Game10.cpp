@@ -1,16 +1,25 @@
 #include "Game10.h"
+#include <array>
+#include <bit>
+#include <cmath>
 #include <iostream>
-#include <cstdlib>
-#include <ctime>
+#include <thread>
 using namespace std;
 
+/**
+ * @brief Uniformly random set bit of a non-empty mask
+ */
+static int random_cell(uint64_t mask, Game_Random& rng) {
+    int k = int(rng.below(popcount(mask)));
+    while (k-- > 0) mask &= mask - 1;
+    return countr_zero(mask);
+}
+
 Game10_Board::Game10_Board() : Board(6, 6) {
     
     for (auto& row : board)
         for (auto& cell : row)
             cell = blank;
-
-    srand((unsigned int)time(0));
 }
 
 bool Game10_Board::update_board(Move<char>* move) {
@@ -19,8 +28,10 @@ bool Game10_Board::update_board(Move<char>* move) {
     char sym = move->get_symbol();
 
     if (x < 0 || x >= 6 || y < 0 || y >= 6) return false;
-    if (board[x][y] != blank) return false;
+    uint64_t bit = 1ull << (x * 6 + y);
+    if (!(position.empty_cells() & bit)) return false;
     board[x][y] = sym;
+    position.play(x * 6 + y);
     n_moves++;
 
     if (n_moves % 2 == 0) {
@@ -33,94 +44,365 @@ bool Game10_Board::update_board(Move<char>* move) {
 }
 
 bool Game10_Board::is_win(Player<char>* player) {
-    char sym = player->get_symbol();
+    return position.has_line(player->get_symbol() == 'X' ? 0 : 1);
+}
 
-    for (int i = 0; i < 6; i++) {
-        for (int j = 0; j <= 2; j++) {
-            if (board[i][j] == sym && board[i][j + 1] == sym &&
-                board[i][j + 2] == sym && board[i][j + 3] == sym) {
-                return true;
-            }
+bool Game10_Board::is_draw(Player<char>* player) {
+    return position.empty_cells() == 0;
+}
+
+bool Game10_Board::game_is_over(Player<char>* player) {
+    return is_win(player) || is_draw(player);
+}
+
+void Game10_Board::add_obstacles() {
+    int obstacles_added = 0;
+
+    while (obstacles_added < 2 && position.empty_cells()) {
+        int cell = random_cell(position.empty_cells(), game_random());
+        int x = cell / 6;
+        int y = cell % 6;
+        position.block(cell);
+        board[x][y] = obstacle;
+        obstacles_added++;
+        cout << "Obstacle added at (" << x << ", " << y << ")\n";
+    }
+
+    if (obstacles_added < 2) {
+        cout << "Warning: Could not add 2 obstacles (board may be nearly full)\n";
+    }
+}
+
+int Game10_Board::count_empty_cells() {
+    return popcount(position.empty_cells());
+}
+
+/// Cells from the center outwards, the order moves are tried in
+static constexpr array<uint8_t, 36> GAME10_MOVE_ORDER = [] {
+    array<uint8_t, 36> order{};
+    for (int i = 0; i < 36; i++) order[i] = uint8_t(i);
+    auto distance = [](int cell) {
+        int dx = 2 * (cell / 6) - 5;
+        int dy = 2 * (cell % 6) - 5;
+        return dx * dx + dy * dy;
+    };
+    for (int i = 1; i < 36; i++)
+        for (int j = i; j > 0 && distance(order[j]) < distance(order[j - 1]); j--) {
+            uint8_t t = order[j]; order[j] = order[j - 1]; order[j - 1] = t;
         }
+    return order;
+}();
+
+/// Leaf score of an open window holding n of one side's marks
+static constexpr double WINDOW_WEIGHT[4] = { 0, 1, 4, 24 };
+
+bool Game10_Expectimax::out_of_time() {
+    nodes++;
+    if (aborted || ((nodes & 4095) == 0 && time_limit_ms > 0 &&
+                    chrono::steady_clock::now() >= deadline)) {
+        aborted = true;
     }
+    return aborted;
+}
 
-    for (int j = 0; j < 6; j++) {
-        for (int i = 0; i <= 2; i++) {
-            if (board[i][j] == sym && board[i + 1][j] == sym &&
-                board[i + 2][j] == sym && board[i + 3][j] == sym) {
-                return true;
-            }
+double Game10_Expectimax::evaluate(const Game10_Position& pos) const {
+    int me = pos.side_to_move();
+    double score = 0;
+    for (uint64_t mask : MNK_LINE_TABLE<6, 6, 4>.masks) {
+        if (pos.blocked_cells() & mask) continue;
+        int mine = popcount(pos.marks(me) & mask);
+        int theirs = popcount(pos.marks(1 - me) & mask);
+        if (theirs == 0) score += WINDOW_WEIGHT[mine];
+        else if (mine == 0) score -= WINDOW_WEIGHT[theirs];
+    }
+    return score;
+}
+
+double Game10_Expectimax::search(const Game10_Position& pos, int depth, double alpha, double beta, int ply) {
+    if (out_of_time()) return 0;
+
+    uint64_t empty = pos.empty_cells();
+    if (empty == 0) return 0;
+
+    int me = pos.side_to_move();
+    for (uint64_t rest = empty; rest; rest &= rest - 1) {
+        Game10_Position child = pos;
+        int cell = countr_zero(rest);
+        child.play(cell);
+        if (child.has_line_through(me, cell)) return WIN_SCORE - ply;
+    }
+
+    if (depth == 0) return evaluate(pos);
+
+    double best = -WIN_SCORE;
+    for (int cell : GAME10_MOVE_ORDER) {
+        if (!((empty >> cell) & 1)) continue;
+
+        Game10_Position child = pos;
+        child.play(cell);
+        double value = (child.moves() % 2 == 0)
+            ? -chance(child, depth - 1, -beta, -alpha, ply + 1)
+            : -search(child, depth - 1, -beta, -alpha, ply + 1);
+        if (aborted) return 0;
+
+        if (value > best) {
+            best = value;
+            if (value > alpha) alpha = value;
+            if (alpha >= beta) break;
         }
     }
+    return best;
+}
 
-    for (int i = 0; i <= 2; i++) {
-        for (int j = 0; j <= 2; j++) {
-            if (board[i][j] == sym && board[i + 1][j + 1] == sym &&
-                board[i + 2][j + 2] == sym && board[i + 3][j + 3] == sym) {
-                return true;
-            }
+double Game10_Expectimax::chance(const Game10_Position& pos, int depth, double alpha, double beta, int ply) {
+    uint64_t empty = pos.empty_cells();
+    int free_cells = popcount(empty);
+    if (free_cells <= 2) return 0;  // the drop fills the board
+    if (depth == 0) return evaluate(pos);
+
+    // Outcomes are equally likely obstacle pairs
+    vector<pair<int, int>> drops;
+    if (free_cells * (free_cells - 1) / 2 <= EXACT_PAIRS) {
+        for (uint64_t a = empty; a; a &= a - 1)
+            for (uint64_t b = a & (a - 1); b; b &= b - 1)
+                drops.push_back({ countr_zero(a), countr_zero(b) });
+    } else {
+        exact = false;
+        for (int i = 0; i < SAMPLED_PAIRS; i++) {
+            int first = random_cell(empty, rng);
+            int second = random_cell(empty & ~(1ull << first), rng);
+            drops.push_back({ first, second });
         }
     }
 
-    for (int i = 0; i <= 2; i++) {
-        for (int j = 3; j < 6; j++) {
-            if (board[i][j] == sym && board[i + 1][j - 1] == sym &&
-                board[i + 2][j - 2] == sym && board[i + 3][j - 3] == sym) {
-                return true;
+    // Star1: the unseen outcomes score at most U and at least L
+    const double lower = -WIN_SCORE, upper = WIN_SCORE;
+    const int n = int(drops.size());
+    double sum = 0;
+    for (int i = 0; i < n; i++) {
+        double child_alpha = max(lower, n * alpha - sum - (n - 1 - i) * upper);
+        double child_beta = min(upper, n * beta - sum - (n - 1 - i) * lower);
+
+        Game10_Position child = pos;
+        child.block(drops[i].first);
+        child.block(drops[i].second);
+        double value = search(child, depth, child_alpha, child_beta, ply);
+        if (aborted) return 0;
+
+        if (value <= child_alpha) return alpha;
+        if (value >= child_beta) return beta;
+        sum += value;
+    }
+    return sum / n;
+}
+
+int Game10_Expectimax::best_move(const Game10_Position& pos, double& score) {
+    nodes = 0;
+    aborted = false;
+    completed_depth = 0;
+    rng.reseed(Game_Random::get_seed() ^ pos.marks(0) ^ pos.marks(1) << 1 ^ pos.blocked_cells() << 2);
+    deadline = chrono::steady_clock::now() + chrono::milliseconds(time_limit_ms);
+
+    uint64_t empty = pos.empty_cells();
+    if (empty == 0) return -1;
+
+    int best_cell = -1;
+    score = 0;
+    int depth_limit = popcount(empty);
+    if (max_depth > 0) depth_limit = min(depth_limit, max_depth);
+
+    for (int depth = 1; depth <= depth_limit; depth++) {
+        int iteration_cell = -1;
+        double alpha = -WIN_SCORE - 1;
+        exact = true;
+
+        // Previous best first, then center outwards
+        vector<int> order;
+        if (best_cell >= 0) order.push_back(best_cell);
+        for (int cell : GAME10_MOVE_ORDER)
+            if (((empty >> cell) & 1) && cell != best_cell) order.push_back(cell);
+
+        for (int cell : order) {
+            Game10_Position child = pos;
+            child.play(cell);
+            double value;
+            if (child.has_line_through(pos.side_to_move(), cell)) value = WIN_SCORE;
+            else if (child.moves() % 2 == 0) value = -chance(child, depth - 1, -WIN_SCORE, -alpha, 1);
+            else value = -search(child, depth - 1, -WIN_SCORE, -alpha, 1);
+            if (aborted) break;
+
+            if (value > alpha) {
+                alpha = value;
+                iteration_cell = cell;
             }
         }
+        if (aborted) break;
+
+        best_cell = iteration_cell;
+        score = alpha;
+        completed_depth = depth;
+        if (exact && abs(alpha) >= WIN_SCORE - depth_limit) break;  // proven
     }
 
-    return false;
+    // Out of time before depth 1 finished: any legal move
+    if (best_cell < 0) best_cell = countr_zero(empty);
+    return best_cell;
 }
 
-bool Game10_Board::is_draw(Player<char>* player) {
-    
-    for (auto& row : board) {
-        for (auto& cell : row) {
-            if (cell == blank) return false;
+/**
+ * @brief Drops up to 2 obstacles on uniformly random empty cells
+ */
+static void drop_obstacles(Game10_Position& pos, Game_Random& rng) {
+    for (int i = 0; i < 2 && pos.empty_cells(); i++)
+        pos.block(random_cell(pos.empty_cells(), rng));
+}
+
+int Game10_Monte_Carlo::playout(Game10_Position& pos, Game_Random& rng) {
+    while (true) {
+        uint64_t empty = pos.empty_cells();
+        if (empty == 0) return -1;
+
+        int side = pos.side_to_move();
+        int cell = random_cell(empty, rng);
+        pos.play(cell);
+        if (pos.has_line_through(side, cell)) return side;
+        if (pos.moves() % 2 == 0) drop_obstacles(pos, rng);
+    }
+}
+
+void Game10_Monte_Carlo::run_worker(Worker& worker, const Game10_Position& root, const vector<int>& moves,
+                                    int first, chrono::steady_clock::time_point deadline) {
+    const int me = root.side_to_move();
+    const int n = int(moves.size());
+    const int threads = max(config.threads, 1);
+    const int rounds = (config.playouts_per_move + threads - 1) / threads;
+
+    for (int round = 0; round < rounds; round++) {
+        if (config.time_limit_ms > 0 && (round & 7) == 0 && chrono::steady_clock::now() >= deadline)
+            return;
+
+        for (int k = 0; k < n; k++) {
+            int cell = moves[(first + k) % n];
+            worker.scratch = root;
+            worker.scratch.play(cell);
+            if (worker.scratch.moves() % 2 == 0) drop_obstacles(worker.scratch, worker.rng);
+
+            int winner = playout(worker.scratch, worker.rng);
+            worker.plays[cell]++;
+            worker.points[cell] += winner == me ? 2 : winner < 0 ? 1 : 0;
         }
     }
-    return true;
 }
 
-bool Game10_Board::game_is_over(Player<char>* player) {
-    return is_win(player) || is_draw(player);
+Game10_Monte_Carlo::~Game10_Monte_Carlo() {
+    {
+        lock_guard<mutex> lock(pool_mutex);
+        stopping = true;
+    }
+    job_ready.notify_all();
+    for (thread& helper : helpers)
+        helper.join();
 }
 
-void Game10_Board::add_obstacles() {
-    int obstacles_added = 0;
-    int max_attempts = 100;
-    int attempts = 0;
-
-    while (obstacles_added < 2 && attempts < max_attempts) {
-        int x = rand() % 6;
-        int y = rand() % 6;
-        if (board[x][y] == blank) {
-            board[x][y] = obstacle;
-            obstacles_added++;
-            cout << "Obstacle added at (" << x << ", " << y << ")\n";
+void Game10_Monte_Carlo::helper_loop(int index) {
+    uint64_t done = 0;
+    unique_lock<mutex> lock(pool_mutex);
+    while (true) {
+        job_ready.wait(lock, [&] { return stopping || generation != done; });
+        if (stopping) return;
+        done = generation;
+
+        lock.unlock();
+        int n_moves = int(job_moves->size());
+        run_worker(workers[index], *job_root, *job_moves, index * n_moves / int(workers.size()), job_deadline);
+        lock.lock();
+
+        if (--running == 0) job_done.notify_one();
+    }
+}
+
+int Game10_Monte_Carlo::best_move(const Game10_Position& pos, double& win_rate) {
+    auto deadline = chrono::steady_clock::now() + chrono::milliseconds(config.time_limit_ms);
+    playouts = 0;
+    win_rate = 0;
+
+    uint64_t empty = pos.empty_cells();
+    if (empty == 0) return -1;
+
+    int me = pos.side_to_move();
+    vector<int> moves;
+    for (int cell : GAME10_MOVE_ORDER) {
+        if (!((empty >> cell) & 1)) continue;
+        Game10_Position child = pos;
+        child.play(cell);
+        if (child.has_line_through(me, cell)) {
+            win_rate = 1;
+            return cell;
         }
-        attempts++;
+        moves.push_back(cell);
     }
 
-    if (obstacles_added < 2) {
-        cout << "Warning: Could not add 2 obstacles (board may be nearly full)\n";
+    int n_threads = max(config.threads, 1);
+    if (workers.empty()) {
+        workers.resize(n_threads);
+        for (int t = 1; t < n_threads; t++)
+            helpers.emplace_back(&Game10_Monte_Carlo::helper_loop, this, t);
+    }
+    uint64_t base = seed + searches++ * 0x9E3779B97F4A7C15ull;
+    for (int t = 0; t < n_threads; t++) {
+        workers[t].rng.reseed(base + uint64_t(t) * 0xD1B54A32D192ED03ull);
+        fill(begin(workers[t].plays), end(workers[t].plays), 0);
+        fill(begin(workers[t].points), end(workers[t].points), 0);
     }
-}
 
-int Game10_Board::count_empty_cells() {
-    int count = 0;
-    for (int i = 0; i < 6; i++) {
-        for (int j = 0; j < 6; j++) {
-            if (board[i][j] == blank) {
-                count++;
-            }
+    {
+        lock_guard<mutex> lock(pool_mutex);
+        job_root = &pos;
+        job_moves = &moves;
+        job_deadline = deadline;
+        running = n_threads - 1;
+        generation++;
+    }
+    job_ready.notify_all();
+    run_worker(workers[0], pos, moves, 0, deadline);
+    {
+        unique_lock<mutex> lock(pool_mutex);
+        job_done.wait(lock, [&] { return running == 0; });
+    }
+
+    int best_cell = moves[0];
+    double best_rate = -1;
+    for (int cell : moves) {
+        uint64_t plays = 0, points = 0;
+        for (int t = 0; t < n_threads; t++) {
+            plays += workers[t].plays[cell];
+            points += workers[t].points[cell];
+        }
+        playouts += plays;
+        if (plays == 0) continue;
+
+        double rate = points / (2.0 * plays);
+        if (rate > best_rate) {
+            best_rate = rate;
+            best_cell = cell;
         }
     }
-    return count;
+    win_rate = max(best_rate, 0.0);
+    return best_cell;
+}
+
+/**
+ * @brief Monte Carlo budget of the player: the defaults on every hardware thread
+ */
+static Game10_Monte_Carlo_Config player_monte_carlo_config() {
+    Game10_Monte_Carlo_Config config;
+    config.threads = max(1u, thread::hardware_concurrency());
+    return config;
 }
 
+Game10_Player::Game10_Player(string n, char s, PlayerType t, Engine e)
+    : Player<char>(n, s, t), engine_type(e), monte_carlo(player_monte_carlo_config(), game_random().next()) {}
+
 vector<Move<char>*> Game10_Player::get_valid_moves() {
     vector<Move<char>*> valid_moves;
     auto board_matrix = boardPtr->get_board_matrix();
@@ -140,7 +422,7 @@ Move<char>* Game10_Player::get_random_move() {
     vector<Move<char>*> moves = get_valid_moves();
 
     if (!moves.empty()) {
-        int random_index = rand() % moves.size();
+        int random_index = game_random().below(moves.size());
         Move<char>* chosen = moves[random_index];
 
         for (int i = 0; i < moves.size(); i++) {
@@ -155,15 +437,76 @@ Move<char>* Game10_Player::get_random_move() {
     return nullptr;
 }
 
+Move<char>* Game10_Player::get_expectimax_move() {
+    const Game10_Position& pos = static_cast<Game10_Board*>(boardPtr)->get_position();
+    double score;
+    int cell = engine.best_move(pos, score);
+    if (cell < 0) return nullptr;
+
+    int x = cell / 6;
+    int y = cell % 6;
+    cout << name << " (" << symbol << ") plays (" << x << ", " << y << ") (expectimax depth "
+         << engine.get_depth() << ", score " << lround(score) << ")\n";
+    return new Move<char>(x, y, symbol);
+}
+
+Move<char>* Game10_Player::get_monte_carlo_move() {
+    const Game10_Position& pos = static_cast<Game10_Board*>(boardPtr)->get_position();
+    double win_rate;
+    int cell = monte_carlo.best_move(pos, win_rate);
+    if (cell < 0) return nullptr;
+
+    int x = cell / 6;
+    int y = cell % 6;
+    cout << name << " (" << symbol << ") plays (" << x << ", " << y << ") (Monte Carlo, "
+         << lround(win_rate * 100) << "% over " << monte_carlo.get_playout_count() << " playouts)\n";
+    return new Move<char>(x, y, symbol);
+}
+
+Move<char>* Game10_Player::get_ai_move() {
+    return engine_type == Engine::MONTE_CARLO ? get_monte_carlo_move() : get_expectimax_move();
+}
+
 Player<char>* Game10_UI::create_player(string& name, char symbol, PlayerType type) {
     return new Game10_Player(name, symbol, type);
 }
 
+Player<char>** Game10_UI::setup_players() {
+    Player<char>** players = new Player<char>*[2];
+    const string labels[2] = { "Player X", "Player O" };
+    const char symbols[2] = { 'X', 'O' };
+
+    for (int i = 0; i < 2; i++) {
+        string name = get_player_name(labels[i]);
+        cout << "Choose " << labels[i] << " type:\n";
+        cout << "1. Human\n";
+        cout << "2. Random Computer\n";
+        cout << "3. Expectimax AI\n";
+        cout << "4. Monte Carlo AI\n";
+        int choice;
+        cin >> choice;
+
+        if (choice == 4) {
+            players[i] = new Game10_Player(name, symbols[i], PlayerType::AI,
+                                           Game10_Player::Engine::MONTE_CARLO);
+            continue;
+        }
+
+        PlayerType type = (choice == 2) ? PlayerType::COMPUTER :
+                          (choice == 3) ? PlayerType::AI : PlayerType::HUMAN;
+        players[i] = create_player(name, symbols[i], type);
+    }
+    return players;
+}
+
 Move<char>* Game10_UI::get_move(Player<char>* player) {
+    Game10_Player* g10player = static_cast<Game10_Player*>(player);
     if (player->get_type() == PlayerType::COMPUTER) {
-        Game10_Player* g10player = static_cast<Game10_Player*>(player);
         return g10player->get_random_move();
     }
+    else if (player->get_type() == PlayerType::AI) {
+        return g10player->get_ai_move();
+    }
     else {
         int x, y;
         cout << player->get_name() << " (" << player->get_symbol() << ")\n";
@@ -3,6 +3,7 @@
 #include <cstdlib>
 #include <cctype>
 #include <algorithm>
+#include <bit>
 using namespace std;
 
 Game7_Board::Game7_Board() : Board(4, 4) {
@@ -36,27 +37,7 @@ bool Game7_Board::update_board(Move<char>* move) {
 }
 
 bool Game7_Board::check_win_for_symbol(char sym) {
-    for (int i = 1; i <= 2; i++) {
-        for (int j = 0; j < 2; j++)
-            if (board[i][j] == sym && board[i][j + 1] == sym && board[i][j + 2] == sym)
-                return true;
-    }
-
-    for (int j = 0; j < 4; j++)
-        for (int i = 0; i < 2; i++)
-            if (board[i][j] == sym && board[i + 1][j] == sym && board[i + 2][j] == sym)
-                return true;
-
-    if (board[0][0] == sym && board[1][1] == sym && board[2][2] == sym) return true;
-    if (board[1][1] == sym && board[2][2] == sym && board[3][3] == sym) return true;
-    if (board[0][1] == sym && board[1][2] == sym && board[2][3] == sym) return true;
-    if (board[1][0] == sym && board[2][1] == sym && board[3][2] == sym) return true;
-    if (board[0][3] == sym && board[1][2] == sym && board[2][1] == sym) return true;
-    if (board[1][2] == sym && board[2][1] == sym && board[3][0] == sym) return true;
-    if (board[0][2] == sym && board[1][1] == sym && board[2][0] == sym) return true;
-    if (board[1][3] == sym && board[2][2] == sym && board[3][1] == sym) return true;
-
-    return false;
+    return Game7_Position::has_three_in_row(to_bitboard(sym));
 }
 
 bool Game7_Board::is_win(Player<char>* player) {
@@ -71,128 +52,108 @@ bool Game7_Board::game_is_over(Player<char>* player) {
     return is_win(player);
 }
 
-int Game7_Board::minimax(char current_player, char ai_symbol, int depth, int max_depth,
-                         int alpha, int beta) {
-    char opponent_symbol = (ai_symbol == 'X') ? 'O' : 'X';
-
-    if (depth >= max_depth) return 0;
-    if (check_win_for_symbol(ai_symbol)) return 10 - depth;
-    if (check_win_for_symbol(opponent_symbol)) return -10 + depth;
-
-    vector<Game7_Move*> valid_moves;
-    int dx[] = { -1, 1, 0, 0 };
-    int dy[] = { 0, 0, -1, 1 };
-
-    for (int i = 0; i < 4; i++) {
-        for (int j = 0; j < 4; j++) {
-            if (board[i][j] == current_player) {
-                for (int k = 0; k < 4; k++) {
-                    int new_i = i + dx[k];
-                    int new_j = j + dy[k];
-                    if (new_i >= 0 && new_i < 4 && new_j >= 0 && new_j < 4) {
-                        if (board[new_i][new_j] == blank) {
-                            valid_moves.push_back(new Game7_Move(i, j, new_i, new_j, current_player));
-                        }
-                    }
-                }
+// Bit (row * 4 + column) of every line of 3 on the board
+static const uint16_t WIN_LINES[] = {
+    // Horizontal lines (rows 1 and 2)
+    0x0070, 0x00E0, 0x0700, 0x0E00,
+    // Vertical lines
+    0x0111, 0x1110, 0x0222, 0x2220, 0x0444, 0x4440, 0x0888, 0x8880,
+    // Diagonals
+    0x0421, 0x8420, 0x0842, 0x4210, 0x0248, 0x1240, 0x0124, 0x2480
+};
+
+// Step applied to a cell index for each direction (up, down, left, right)
+static const int STEP[] = { -4, 4, -1, 1 };
+
+uint16_t Game7_Board::to_bitboard(char symbol) const {
+    uint16_t bits = 0;
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+            if (board[i][j] == symbol)
+                bits |= uint16_t(1u << (i * 4 + j));
+    return bits;
+}
+
+void Game7_Position::generate_moves(uint16_t own, uint16_t empty, Game7_MoveList& list) {
+    // Destinations reachable by one step in each direction; the column
+    // masks drop tokens that would wrap around to the neighbouring row.
+    const uint16_t dest[4] = {
+        uint16_t((own >> 4) & empty),
+        uint16_t((own << 4) & empty),
+        uint16_t(((own & 0xEEEE) >> 1) & empty),
+        uint16_t(((own & 0x7777) << 1) & empty)
+    };
+
+    list.count = 0;
+    for (uint16_t rest = own; rest; rest &= rest - 1) {
+        int from = countr_zero(rest);
+        for (int k = 0; k < 4; k++) {
+            int to = from + STEP[k];
+            if (to >= 0 && to < 16 && (dest[k] >> to & 1)) {
+                list.from[list.count] = uint8_t(from);
+                list.to[list.count] = uint8_t(to);
+                list.count++;
             }
         }
     }
+}
 
-    if (valid_moves.empty()) {
-        return 0;
-    }
-
-    bool is_maximizing = (current_player == ai_symbol);
-    int best_score = is_maximizing ? -1000000 : 1000000;
-
-    for (auto move : valid_moves) {
-        int from_x = move->get_from_x();
-        int from_y = move->get_from_y();
-        int to_x = move->get_x();
-        int to_y = move->get_y();
-
-        board[from_x][from_y] = blank;
-        board[to_x][to_y] = current_player;
-
-        char next_player = is_maximizing ? opponent_symbol : ai_symbol;
-        int score = minimax(next_player, ai_symbol, depth + 1, max_depth, alpha, beta);
+bool Game7_Position::has_three_in_row(uint16_t bits) {
+    for (uint16_t line : WIN_LINES)
+        if ((bits & line) == line) return true;
+    return false;
+}
 
-        board[from_x][from_y] = current_player;
-        board[to_x][to_y] = blank;
+int Game7_Position::generate_moves(Move* moves) const {
+    Game7_MoveList list;
+    generate_moves(tokens[side], uint16_t(~(tokens[0] | tokens[1])), list);
+    for (int m = 0; m < list.count; m++)
+        moves[m] = Move(list.from[m] << 4 | list.to[m]);
+    return list.count;
+}
 
-        if (is_maximizing) {
-            best_score = max(best_score, score);
-            alpha = max(alpha, score);
-        } else {
-            best_score = min(best_score, score);
-            beta = min(beta, score);
-        }
+// Score of an open line holding n of one side's tokens
+static const int LINE_WEIGHT[3] = { 0, 1, 4 };
 
-        if (beta <= alpha) break;
+int Game7_Position::evaluate() const {
+    uint16_t mine = tokens[side], theirs = tokens[side ^ 1];
+    int score = 0;
+    for (uint16_t line : WIN_LINES) {
+        if (!(theirs & line)) score += LINE_WEIGHT[popcount(uint16_t(mine & line))];
+        else if (!(mine & line)) score -= LINE_WEIGHT[popcount(uint16_t(theirs & line))];
     }
-
-    for (auto move : valid_moves) delete move;
-    return best_score;
+    return score;
 }
 
 Game7_Move* Game7_Board::get_best_move(char ai_symbol, int difficulty) {
-    char opponent_symbol = (ai_symbol == 'X') ? 'O' : 'X';
-    int best_score = -1000000;
-    Game7_Move* best_move = nullptr;
-    int alpha = -1000000;
-    int beta = 1000000;
-
     cout << "AI is thinking with (difficulty: " << difficulty << ")...\n";
 
-    for (int i = 0; i < 4; i++) {
-        for (int j = 0; j < 4; j++) {
-            if (board[i][j] == ai_symbol) {
-                int dx[] = { -1, 1, 0, 0 };
-                int dy[] = { 0, 0, -1, 1 };
-
-                for (int k = 0; k < 4; k++) {
-                    int new_i = i + dx[k];
-                    int new_j = j + dy[k];
-
-                    if (new_i >= 0 && new_i < 4 && new_j >= 0 && new_j < 4) {
-                        if (board[new_i][new_j] == blank) {
-                            board[i][j] = blank;
-                            board[new_i][new_j] = ai_symbol;
-
-                            int score = minimax(opponent_symbol, ai_symbol, 0, difficulty,
-                                              alpha, beta);
-
-                            board[i][j] = ai_symbol;
-                            board[new_i][new_j] = blank;
-
-                            if (score > best_score) {
-                                best_score = score;
-                                if (best_move) delete best_move;
-                                best_move = new Game7_Move(i, j, new_i, new_j, ai_symbol);
-                            }
-
-                            alpha = max(alpha, best_score);
-                        }
-                    }
-                }
-            }
-        }
-    }
+    Game7_Position root;
+    root.tokens[0] = to_bitboard('X');
+    root.tokens[1] = to_bitboard('O');
+    root.side = ai_symbol == 'X' ? 0 : 1;
 
-    if (best_move) {
-        cout << "AI chooses (" << best_move->get_from_x() << ","
-             << best_move->get_from_y() << ") -> ("
-             << best_move->get_x() << "," << best_move->get_y()
-             << ") with score: " << best_score << "\n";
-    }
+    Search_Config config;
+    config.max_depth = difficulty + 1;
+    config.time_limit_ms = 3000;
+    Search<Game7_Position> engine(config);
+    int move = engine.search(root);
+    if (move < 0) return nullptr;
+
+    int from = move >> 4, to = move & 15;
+    Game7_Move* best_move = new Game7_Move(from / 4, from % 4, to / 4, to % 4, ai_symbol);
+
+    cout << "AI chooses (" << best_move->get_from_x() << ","
+         << best_move->get_from_y() << ") -> ("
+         << best_move->get_x() << "," << best_move->get_y()
+         << ") with score: " << engine.get_stats().score << "\n";
 
     return best_move;
 }
 
 Move<char>* Game7_Player::get_move() {
     Game7_Board* g7board = static_cast<Game7_Board*>(this->boardPtr);
-    Game7_Move* move = g7board->get_best_move(symbol, 5);
+    Game7_Move* move = g7board->get_best_move(symbol, 9);
     return move;
 }
 
@@ -3,14 +3,17 @@
  * @brief Complete implementation of 5x5 Tic-Tac-Toe with AI in a single file
  *
  * This file contains all classes and implementations for the 5x5 variant
- * including Smart AI using Minimax algorithm with Alpha-Beta pruning.
+ * including a Smart AI that searches with the shared alpha-beta engine.
  */
 
 #include "BoardGame_Classes.h"
+#include "Game_Random.h"
+#include "Game_Search.h"
+#include "MNK_Board.h"
+#include <bit>
 #include <iostream>
 #include <iomanip>
 #include <cstdlib>
-#include <ctime>
 #include <limits>
 #include <vector>
 #include <stdexcept>
@@ -19,6 +22,9 @@
 
 using namespace std;
 
+/// Lines of 3 on the 5x5 board, bit row * 5 + col
+using FiveByFive_Lines = MNK_Lines<5, 5, 3>;
+
 // ============================================================================
 // EXCEPTION CLASSES
 // ============================================================================
@@ -161,41 +167,7 @@ int FiveByFiveBoard::count_three_in_a_row(char symbol) {
         return 0;
     }
 
-    int count = 0;
-
-    // Horizontal
-    for (int r = 0; r < 5; ++r)
-        for (int c = 0; c <= 2; ++c)
-            if (board[r][c] == symbol &&
-                board[r][c + 1] == symbol &&
-                board[r][c + 2] == symbol)
-                ++count;
-
-    // Vertical
-    for (int r = 0; r <= 2; ++r)
-        for (int c = 0; c < 5; ++c)
-            if (board[r][c] == symbol &&
-                board[r + 1][c] == symbol &&
-                board[r + 2][c] == symbol)
-                ++count;
-
-    // Diagonal down-right
-    for (int r = 0; r <= 2; ++r)
-        for (int c = 0; c <= 2; ++c)
-            if (board[r][c] == symbol &&
-                board[r + 1][c + 1] == symbol &&
-                board[r + 2][c + 2] == symbol)
-                ++count;
-
-    // Diagonal down-left
-    for (int r = 0; r <= 2; ++r)
-        for (int c = 2; c < 5; ++c)
-            if (board[r][c] == symbol &&
-                board[r + 1][c - 1] == symbol &&
-                board[r + 2][c - 2] == symbol)
-                ++count;
-
-    return count;
+    return FiveByFive_Lines::count_lines(FiveByFive_Lines::marks_of(board, symbol));
 }
 
 /**
@@ -299,6 +271,64 @@ void FiveByFiveBoard::show_score() {
         cout << "It's a draw.\n";
 }
 
+// ============================================================================
+// SEARCH POSITION
+// ============================================================================
+
+/// Rules of 5x5 Tic-Tac-Toe: 24 moves are played, then more three-in-a-rows wins
+struct FiveByFive_Rules : MNK_Rules {
+    static constexpr bool SCORING = true;
+    static constexpr int MOVE_LIMIT = 24;
+};
+
+/**
+ * @struct FiveByFive_Position
+ * @brief 5x5 position for Search: an MNKBoard under FiveByFive_Rules, bit row * 5 + col
+ * @details The game ends after MOVE_LIMIT moves and is won by the side with
+ *          more three-in-a-rows, so only then is a position terminal.
+ */
+struct FiveByFive_Position : MNKBoard<5, 5, 3, FiveByFive_Rules> {
+    using MNKBoard::MNKBoard;
+    using Move = uint8_t;
+    static const int MAX_MOVES = 25;   ///< Cells on the board
+    static const int MOVE_SPACE = 25;  ///< Move values are cell indices
+
+    int generate_moves(Move* moves) const {
+        int count = 0;
+        for (uint32_t empty = legal_moves(); empty; empty &= empty - 1)
+            moves[count++] = Move(countr_zero(empty));
+        return count;
+    }
+
+    void make(Move cell) { play(cell); }
+    void unmake(Move cell) { unplay(cell); }
+
+    /**
+     * @brief Completed lines are worth 16, lines with two marks and a free cell 1
+     */
+    int evaluate() const {
+        uint32_t mine = marks(side_to_move()), theirs = marks(side_to_move() ^ 1);
+        int score = 16 * (FiveByFive_Lines::count_lines(mine) - FiveByFive_Lines::count_lines(theirs));
+        for (uint32_t line : MNK_LINE_TABLE<5, 5, 3>.masks) {
+            if (!(theirs & line) && popcount(mine & line) == 2) score++;
+            else if (!(mine & line) && popcount(theirs & line) == 2) score--;
+        }
+        return score;
+    }
+
+    uint64_t hash() const {
+        uint64_t key = marks(0) | uint64_t(marks(1)) << 25 | uint64_t(side_to_move()) << 50;
+        return Game_Random::splitmix64(key);
+    }
+
+    bool is_terminal(int& result) const {
+        if (!is_over()) return false;
+        int side = winner();
+        result = side < 0 ? 0 : side == side_to_move() ? 1 : -1;
+        return true;
+    }
+};
+
 // ============================================================================
 // PLAYER CLASSES
 // ============================================================================
@@ -325,127 +355,14 @@ public:
 
 /**
  * @class FiveByFiveAIPlayer
- * @brief Smart AI player using Minimax algorithm with Alpha-Beta pruning
+ * @brief Smart AI player searching with Search<FiveByFive_Position>
  */
 class FiveByFiveAIPlayer : public Player<char> {
 private:
-    static const int MAX_DEPTH = 3;
+    static const int TIME_LIMIT_MS = 1000;
 
     /**
-     * @brief Count all three-in-a-row patterns for a given symbol
-     */
-    int count_patterns(const vector<vector<char>>& board, char symbol) {
-        int count = 0;
-
-        // Horizontal
-        for (int r = 0; r < 5; ++r)
-            for (int c = 0; c <= 2; ++c)
-                if (board[r][c] == symbol &&
-                    board[r][c+1] == symbol &&
-                    board[r][c+2] == symbol)
-                    ++count;
-
-        // Vertical
-        for (int r = 0; r <= 2; ++r)
-            for (int c = 0; c < 5; ++c)
-                if (board[r][c] == symbol &&
-                    board[r+1][c] == symbol &&
-                    board[r+2][c] == symbol)
-                    ++count;
-
-        // Diagonal down-right
-        for (int r = 0; r <= 2; ++r)
-            for (int c = 0; c <= 2; ++c)
-                if (board[r][c] == symbol &&
-                    board[r+1][c+1] == symbol &&
-                    board[r+2][c+2] == symbol)
-                    ++count;
-
-        // Diagonal down-left
-        for (int r = 0; r <= 2; ++r)
-            for (int c = 2; c < 5; ++c)
-                if (board[r][c] == symbol &&
-                    board[r+1][c-1] == symbol &&
-                    board[r+2][c-2] == symbol)
-                    ++count;
-
-        return count;
-    }
-
-    /**
-     * @brief Evaluate board position
-     */
-    int evaluate_board(const vector<vector<char>>& board, char symbol) {
-        char opponent = (symbol == 'X') ? 'O' : 'X';
-        int myScore = count_patterns(board, symbol);
-        int oppScore = count_patterns(board, opponent);
-        return myScore - oppScore;
-    }
-
-    /**
-     * @brief Get all empty cells on the board
-     */
-    vector<pair<int, int>> get_empty_cells(const vector<vector<char>>& board) {
-        vector<pair<int, int>> empty;
-        for (int i = 0; i < 5; ++i)
-            for (int j = 0; j < 5; ++j)
-                if (board[i][j] == '.')
-                    empty.push_back({i, j});
-        return empty;
-    }
-
-    /**
-     * @brief Minimax algorithm with Alpha-Beta pruning
-     */
-    int minimax(vector<vector<char>> board, int depth, int alpha, int beta,
-                bool is_maximizing, int moves_made) {
-
-        if (moves_made >= 24 || depth == 0) {
-            return evaluate_board(board, this->symbol);
-        }
-
-        vector<pair<int, int>> empty = get_empty_cells(board);
-        if (empty.empty()) {
-            return evaluate_board(board, this->symbol);
-        }
-
-        if (is_maximizing) {
-            int max_eval = numeric_limits<int>::min();
-
-            for (auto& cell : empty) {
-                board[cell.first][cell.second] = this->symbol;
-                int eval = minimax(board, depth - 1, alpha, beta, false, moves_made + 1);
-                board[cell.first][cell.second] = '.';
-
-                max_eval = max(max_eval, eval);
-                alpha = max(alpha, eval);
-
-                if (beta <= alpha)
-                    break;
-            }
-            return max_eval;
-
-        } else {
-            int min_eval = numeric_limits<int>::max();
-            char opponent = (this->symbol == 'X') ? 'O' : 'X';
-
-            for (auto& cell : empty) {
-                board[cell.first][cell.second] = opponent;
-                int eval = minimax(board, depth - 1, alpha, beta, true, moves_made + 1);
-                board[cell.first][cell.second] = '.';
-
-                min_eval = min(min_eval, eval);
-                beta = min(beta, eval);
-
-                if (beta <= alpha)
-                    break;
-            }
-            return min_eval;
-        }
-    }
-
-    /**
-     * @brief Find the best move using Minimax
+     * @brief Find the best move by iterative-deepening alpha-beta search
      */
     pair<int, int> find_best_move() {
         Board<char>* board_ptr = this->get_board_ptr();
@@ -455,47 +372,24 @@ private:
         }
 
         vector<vector<char>> board = board_ptr->get_board_matrix();
-        vector<pair<int, int>> empty = get_empty_cells(board);
+        FiveByFive_Position root(FiveByFive_Lines::marks_of(board, 'X'), FiveByFive_Lines::marks_of(board, 'O'));
 
-        if (empty.empty()) {
-            cerr << "[AI ERROR] No empty cells\n";
-            return {-1, -1};
-        }
-
-        int best_score = numeric_limits<int>::min();
-        pair<int, int> best_move = empty[0];
-
-        // Count current moves from board
-        int moves_made = 0;
-        for (int i = 0; i < 5; ++i)
-            for (int j = 0; j < 5; ++j)
-                if (board[i][j] != '.')
-                    ++moves_made;
-
-        cout << "\n[AI] Thinking";
+        cout << "\n[AI] Thinking...";
         cout.flush();
 
-        for (auto& cell : empty) {
-            board[cell.first][cell.second] = this->symbol;
-
-            int score = minimax(board, MAX_DEPTH - 1,
-                                numeric_limits<int>::min(),
-                                numeric_limits<int>::max(),
-                                false, moves_made + 1);
+        Search_Config config;
+        config.time_limit_ms = TIME_LIMIT_MS;
+        Search<FiveByFive_Position> engine(config);
+        int cell = engine.search(root);
 
-            board[cell.first][cell.second] = '.';
-
-            cout << ".";
-            cout.flush();
-
-            if (score > best_score) {
-                best_score = score;
-                best_move = cell;
-            }
+        if (cell < 0) {
+            cerr << "[AI ERROR] No empty cells\n";
+            return {-1, -1};
         }
 
-        cout << " Done! (Score: " << best_score << ")\n";
-        return best_move;
+        cout << " Done! (Score: " << engine.get_stats().score
+             << ", depth " << engine.get_stats().depth << ")\n";
+        return {cell / 5, cell % 5};
     }
 
 public:
@@ -600,7 +494,7 @@ Move<char>* FiveByFiveUI::get_move(Player<char>* player) {
         return nullptr;
     }
 
-    int randomIndex = rand() % emptyCells.size();
+    int randomIndex = game_random().below(emptyCells.size());
     int r = emptyCells[randomIndex].first;
     int c = emptyCells[randomIndex].second;
 
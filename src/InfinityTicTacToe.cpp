@@ -1,20 +1,169 @@
 
 #include "InfinityTicTacToe.h"
 #include <iostream>
-#include <cstdlib>
-#include <ctime>
+#include <vector>
+#include "Game_Random.h"
 
 using namespace std;
 
+// ===== Infinity_Solver Implementation =====
 
-InfinityBoard::InfinityBoard() : Board<char>(3, 3), move_counter(0) {
+/// Number of ordered selections of k cells out of n
+static constexpr long long arrangements(int n, int k) {
+    long long count = 1;
+    for (int i = 0; i < k; i++) count *= n - i;
+    return count;
+}
+
+/// Marks on the board after m moves: 2 for every 3 moves
+static constexpr int layer_length(int m) { return m - m / 3; }
+
+/// Layer of a position from its mark count and vanish counter
+static int layer_of(int length, int counter) {
+    return 3 * ((length - counter) / 2) + counter;
+}
+
+/// Rank of a placement order among all orders of the same length
+static long long rank_order(const Infinity_State& state) {
+    long long rank = 0;
+    uint16_t used = 0;
+    for (int i = 0; i < state.length; i++) {
+        int cell = state.at(i);
+        int smaller_free = 0;
+        for (int c = 0; c < cell; c++)
+            if (!((used >> c) & 1)) smaller_free++;
+        rank += smaller_free * arrangements(8 - i, state.length - 1 - i);
+        used |= 1 << cell;
+    }
+    return rank;
+}
+
+/// Inverse of rank_order
+static Infinity_State unrank_order(long long rank, int length, int counter) {
+    Infinity_State state;
+    state.length = uint8_t(length);
+    state.counter = uint8_t(counter);
+    uint16_t used = 0;
+    for (int i = 0; i < length; i++) {
+        long long block = arrangements(8 - i, length - 1 - i);
+        int skip = int(rank / block);
+        rank %= block;
+        int c = 0;
+        while ((used >> c) & 1) c++;
+        while (skip-- > 0) {
+            c++;
+            while ((used >> c) & 1) c++;
+        }
+        state.cells[i] = uint8_t(c);
+        used |= 1 << c;
+    }
+    return state;
+}
+
+/// Table entry: result in the top 2 bits, distance in the low 6
+static uint8_t encode_entry(Infinity_Solver::Result result, int distance) {
+    return uint8_t(result << 6 | distance);
+}
+
+/**
+ * @brief The solved layers, one byte per position
+ */
+struct Infinity_Table {
+    vector<uint8_t> layers[Infinity_Solver::MAX_MOVES + 1];
+
+    Infinity_Table() {
+        for (int m = Infinity_Solver::MAX_MOVES; m >= 0; m--) {
+            int length = layer_length(m);
+            layers[m].resize(size_t(arrangements(9, length)));
+
+            for (long long rank = 0; rank < (long long)layers[m].size(); rank++)
+                layers[m][rank] = solve(unrank_order(rank, length, m % 3), m);
+        }
+    }
+
+    /// Value of one position, with every later layer already solved
+    uint8_t solve(const Infinity_State& state, int m) const {
+        uint16_t occupied = state.occupied();
+
+        int best_win = -1, worst_loss = -1;
+        bool draw = false;
+        for (int cell = 0; cell < 9; cell++) {
+            if ((occupied >> cell) & 1) continue;
+
+            Infinity_State child = state;
+            child.place(cell);
+            if (Infinity_Lines::has_line(child.last_mover())) {
+                best_win = 1;
+                break;
+            }
+
+            uint8_t entry = layers[m + 1][rank_order(child)];
+            int result = entry >> 6, distance = entry & 63;
+            if (result == Infinity_Solver::LOSS) {
+                if (best_win < 0 || distance + 1 < best_win) best_win = distance + 1;
+            } else if (result == Infinity_Solver::DRAW) {
+                draw = true;
+            } else if (distance + 1 > worst_loss) {
+                worst_loss = distance + 1;
+            }
+        }
+
+        if (best_win >= 0) return encode_entry(Infinity_Solver::WIN, best_win);
+        if (draw || worst_loss < 0) return encode_entry(Infinity_Solver::DRAW, 0);
+        return encode_entry(Infinity_Solver::LOSS, worst_loss);
+    }
+};
+
+static const Infinity_Table& infinity_table() {
+    static const Infinity_Table table;
+    return table;
+}
+
+Infinity_Solver::Result Infinity_Solver::lookup(const Infinity_State& state, int& distance) {
+    uint8_t entry = infinity_table().layers[layer_of(state.length, state.counter)][rank_order(state)];
+    distance = entry & 63;
+    return Result(entry >> 6);
+}
+
+int Infinity_Solver::best_move(const Infinity_State& state, Result& result, int& distance) {
+    result = lookup(state, distance);
+    uint16_t occupied = state.occupied();
+
+    int fallback = -1;
+    for (int cell = 0; cell < 9; cell++) {
+        if ((occupied >> cell) & 1) continue;
+        if (fallback < 0) fallback = cell;
+
+        Infinity_State child = state;
+        child.place(cell);
+        bool wins = Infinity_Lines::has_line(child.last_mover());
+
+        // The move that realizes the table value: the child's value is the
+        // negation of ours, one ply closer to the end
+        int child_distance = 0;
+        Result child_result = wins ? LOSS : lookup(child, child_distance);
+        if (result == WIN && child_result == LOSS && child_distance + 1 == distance) return cell;
+        if (result == DRAW && child_result == DRAW) return cell;
+        if (result == LOSS && child_result == WIN && child_distance + 1 == distance) return cell;
+    }
+    return fallback;
+}
+
+long long Infinity_Solver::state_count() {
+    long long count = 0;
+    for (const auto& layer : infinity_table().layers) count += layer.size();
+    return count;
+}
+
+// ===== InfinityBoard Implementation =====
+
+
+InfinityBoard::InfinityBoard() : Board<char>(3, 3) {
     for (int i = 0; i < 3; i++) {
         for (int j = 0; j < 3; j++) {
             board[i][j] = blank;
         }
     }
-
-    srand(static_cast<unsigned>(time(0)));
 }
 
 bool InfinityBoard::update_board(Move<char>* move) {
@@ -28,57 +177,19 @@ bool InfinityBoard::update_board(Move<char>* move) {
     board[x][y] = symbol;
     n_moves++;
 
-    // Add move to queue
-    move_history.push({x, y});
-    move_counter++;
-
-    if (move_counter == 3) {
+    int vanished = state.place(x * 3 + y);
+    if (vanished >= 0) {
         cout << "\n>>> REMOVING OLDEST MOVE <<<\n";
-        remove_oldest_move();
-        move_counter = 0;
+        board[vanished / 3][vanished % 3] = blank;
+        n_moves--;
+        cout << ">>> Move at position (" << vanished / 3 << ", " << vanished % 3 << ") has vanished! <<<\n\n";
     }
 
     return true;
 }
 
-void InfinityBoard::remove_oldest_move() {
-    if (move_history.empty()) return;
-
-    // Get the oldest move
-    auto [x, y] = move_history.front();
-    move_history.pop();
-
-    // Remove it from the board
-    board[x][y] = blank;
-    n_moves--;
-
-    cout << ">>> Move at position (" << x << ", " << y << ") has vanished! <<<\n\n";
-}
-
 bool InfinityBoard::check_win_for_symbol(char symbol) {
-    // Check rows
-    for (int i = 0; i < 3; i++) {
-        if (board[i][0] == symbol && board[i][1] == symbol && board[i][2] == symbol) {
-            return true;
-        }
-    }
-
-    // Check columns
-    for (int j = 0; j < 3; j++) {
-        if (board[0][j] == symbol && board[1][j] == symbol && board[2][j] == symbol) {
-            return true;
-        }
-    }
-
-    // Check diagonals
-    if (board[0][0] == symbol && board[1][1] == symbol && board[2][2] == symbol) {
-        return true;
-    }
-    if (board[0][2] == symbol && board[1][1] == symbol && board[2][0] == symbol) {
-        return true;
-    }
-
-    return false;
+    return Infinity_Lines::has_line(Infinity_Lines::marks_of(board, symbol));
 }
 
 bool InfinityBoard::is_win(Player<char>* player) {
@@ -90,11 +201,11 @@ bool InfinityBoard::is_lose(Player<char>*) {
 }
 
 bool InfinityBoard::is_draw(Player<char>* player) {
-    return false;
+    return state.length == 9 && !is_win(player);
 }
 
 bool InfinityBoard::game_is_over(Player<char>* player) {
-    return is_win(player);
+    return is_win(player) || is_draw(player);
 }
 
 // ===== InfinityPlayer Implementation =====
@@ -117,13 +228,29 @@ Move<char>* InfinityPlayer::get_random_move() {
 
     if (valid_moves.empty()) return nullptr;
 
-    auto chosen = valid_moves[rand() % valid_moves.size()];
+    auto chosen = valid_moves[game_random().below(valid_moves.size())];
     cout << name << " places '" << symbol << "' at ("
          << chosen.first << ", " << chosen.second << ")\n";
 
     return new Move<char>(chosen.first, chosen.second, symbol);
 }
 
+Move<char>* InfinityPlayer::get_perfect_move() {
+    InfinityBoard* ib = static_cast<InfinityBoard*>(this->boardPtr);
+    Infinity_Solver::Result result;
+    int distance;
+    int cell = Infinity_Solver::best_move(ib->get_state(), result, distance);
+    if (cell < 0) return nullptr;
+
+    int x = cell / 3, y = cell % 3;
+    cout << name << " places '" << symbol << "' at (" << x << ", " << y << ") (perfect play, ";
+    if (result == Infinity_Solver::WIN) cout << "wins in " << (distance + 1) / 2 << " moves)\n";
+    else if (result == Infinity_Solver::LOSS) cout << "loses in " << distance / 2 << " moves)\n";
+    else cout << "draw)\n";
+
+    return new Move<char>(x, y, symbol);
+}
+
 // ===== InfinityUI Implementation =====
 
 InfinityUI::InfinityUI() : UI<char>("Infinity Tic-Tac-Toe", 3) {
@@ -132,7 +259,9 @@ InfinityUI::InfinityUI() : UI<char>("Infinity Tic-Tac-Toe", 3) {
     cout << "- Standard 3x3 Tic-Tac-Toe board\n";
     cout << "- After every 3 moves, the OLDEST move vanishes!\n";
     cout << "- Win by getting 3 in a row BEFORE those marks vanish\n";
-    cout << "- The game continues infinitely until someone wins!\n\n";
+    cout << "- Two marks stay for every three moves, so the board fills up:\n";
+    cout << "  if the next player has no empty cell, the game is a draw\n\n";
+    player_type_options = { "Human", "Random Computer", "Perfect AI (Solver)" };
 }
 
 Player<char>* InfinityUI::create_player(string& name, char symbol, PlayerType type) {
@@ -144,6 +273,10 @@ Move<char>* InfinityUI::get_move(Player<char>* player) {
         InfinityPlayer* ip = static_cast<InfinityPlayer*>(player);
         return ip->get_random_move();
     }
+    if (player->get_type() == PlayerType::AI) {
+        InfinityPlayer* ip = static_cast<InfinityPlayer*>(player);
+        return ip->get_perfect_move();
+    }
 
     int x, y;
     cout << player->get_name() << " (" << player->get_symbol() << "), enter position (row col): ";
@@ -1,6 +1,6 @@
 #include "Memory_Classes.h"
-#include <cstdlib>
-#include <ctime>
+#include <bit>
+#include <cmath>
 
 // ---------------- Memory_Board ----------------
 
@@ -17,8 +17,7 @@ bool Memory_Board::update_board(Move<char>* move) {
         board[x][y] = toupper(mark);
         n_moves++;
 
-        // Store the move in history
-        move_history.push_back(make_tuple(x, y, toupper(mark)));
+        move_order[n_moves - 1] = uint8_t(x * 3 + y);
 
         return true;
     }
@@ -26,21 +25,7 @@ bool Memory_Board::update_board(Move<char>* move) {
 }
 
 bool Memory_Board::is_win(Player<char>* player) {
-    char sym = player->get_symbol();
-    auto all_equal = [&](char a, char b, char c) {
-        return a == b && b == c && a != blank_symbol;
-    };
-
-    for (int i = 0; i < rows; i++)
-        if ((all_equal(board[i][0], board[i][1], board[i][2]) && board[i][0] == sym) ||
-            (all_equal(board[0][i], board[1][i], board[2][i]) && board[0][i] == sym))
-            return true;
-
-    if ((all_equal(board[0][0], board[1][1], board[2][2]) && board[1][1] == sym) ||
-        (all_equal(board[0][2], board[1][1], board[2][0]) && board[1][1] == sym))
-        return true;
-
-    return false;
+    return Memory_Lines::has_line(Memory_Lines::marks_of(board, player->get_symbol()));
 }
 
 bool Memory_Board::is_draw(Player<char>* player) {
@@ -51,6 +36,185 @@ bool Memory_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
+// ---------------- Memory_Belief ----------------
+
+Memory_Belief::Memory_Belief(const Memory_Recall_Config& config)
+    : window(uint8_t(config.window > 0 && config.window < 9 ? config.window : 9)),
+      keep(config.retention >= 1.0 ? UINT32_MAX : uint32_t(max(config.retention, 0.0) * 4294967296.0)) {}
+
+void Memory_Belief::observe(int cell, Game_Random& rng) {
+    if (keep != UINT32_MAX) {
+        for (uint16_t& mask : known) {
+            for (uint16_t rest = mask; rest; rest &= rest - 1)
+                if (uint32_t(rng.next() >> 32) >= keep) mask &= ~(rest & -rest);
+        }
+    }
+
+    int side = n_observed % 2;
+    known[side] |= 1 << cell;
+    taken |= 1 << cell;
+    order[n_observed++] = uint8_t(cell);
+
+    if (n_observed > window) {
+        int forgotten = order[n_observed - 1 - window];
+        known[0] &= ~(1 << forgotten);
+        known[1] &= ~(1 << forgotten);
+    }
+}
+
+// ---------------- Memory_ISMCTS ----------------
+
+/** @brief Uniformly random set bit of a non-empty mask */
+static int random_cell(uint16_t mask, Game_Random& rng) {
+    int k = int(rng.below(popcount(mask)));
+    while (k-- > 0) mask &= mask - 1;
+    return countr_zero(mask);
+}
+
+Memory_ISMCTS::Memory_ISMCTS(const Memory_ISMCTS_Config& config, uint64_t seed)
+    : config(config), rng(seed) {}
+
+bool Memory_ISMCTS::determinize(uint16_t occupied, uint16_t known_x, uint16_t known_o, Game_Random& rng,
+                                uint16_t& x, uint16_t& o) {
+    // X moves first, so X has the extra mark when the count is odd
+    int marks = popcount(occupied);
+    int missing_x = (marks + 1) / 2 - popcount(known_x);
+    uint16_t unknown = occupied & ~(known_x | known_o);
+
+    for (int attempt = 0; attempt < 64; attempt++) {
+        x = known_x;
+        uint16_t rest = unknown;
+        for (int i = 0; i < missing_x && rest; i++) {
+            int cell = random_cell(rest, rng);
+            x |= 1 << cell;
+            rest &= ~(1 << cell);
+        }
+        o = occupied & ~x;
+        if (!Memory_Lines::has_line(x) && !Memory_Lines::has_line(o)) return true;
+    }
+    return false;
+}
+
+bool Memory_ISMCTS::expand(int node, uint16_t occupied) {
+    int n = 9 - popcount(occupied);
+    if (node_count + n > int(nodes.size())) return false;
+
+    nodes[node].first_child = node_count;
+    nodes[node].n_children = uint8_t(n);
+    for (int cell = 0; cell < 9; cell++) {
+        if ((occupied >> cell) & 1) continue;
+        nodes[node_count] = Node();
+        nodes[node_count].move = uint8_t(cell);
+        node_count++;
+    }
+    return true;
+}
+
+int Memory_ISMCTS::search(uint16_t occupied, uint16_t known_x, uint16_t known_o) {
+    best_value = 0;
+    if (occupied == 0x1FF) return -1;
+
+    if (int(nodes.size()) < config.max_nodes) nodes.resize(config.max_nodes);
+    nodes[0] = Node();
+    node_count = 1;
+    expand(0, occupied);
+    const int root_side = popcount(occupied) % 2;
+
+    int path[10];
+    for (int iteration = 0; iteration < config.playouts; iteration++) {
+        uint16_t marks[2];
+        determinize(occupied, known_x, known_o, rng, marks[0], marks[1]);
+        uint16_t taken = occupied;
+        int side = root_side;
+        int winner = -1;
+        bool over = false;
+
+        // Selection and expansion through the shared tree
+        int depth = 0;
+        int node = 0;
+        path[depth++] = node;
+        while (!over) {
+            if (nodes[node].first_child < 0) {
+                if (nodes[node].visits == 0 || !expand(node, taken)) break;
+            }
+
+            const Node& parent = nodes[node];
+            double log_visits = log(double(parent.visits) + 1);
+            int best = -1;
+            double best_ucb = -1;
+            for (int c = parent.first_child; c < parent.first_child + parent.n_children; c++) {
+                const Node& child = nodes[c];
+                double ucb = child.visits == 0
+                    ? 1e9 + rng.below(1024)
+                    : child.score / child.visits + config.exploration * sqrt(log_visits / child.visits);
+                if (ucb > best_ucb) {
+                    best_ucb = ucb;
+                    best = c;
+                }
+            }
+
+            node = best;
+            path[depth++] = node;
+            int cell = nodes[node].move;
+            marks[side] |= 1 << cell;
+            taken |= 1 << cell;
+            if (Memory_Lines::has_line(marks[side])) {
+                winner = side;
+                over = true;
+            } else if (taken == 0x1FF) {
+                over = true;
+            }
+            side ^= 1;
+        }
+
+        // Random playout from the leaf
+        while (!over) {
+            int cell = random_cell(uint16_t(0x1FF & ~taken), rng);
+            marks[side] |= 1 << cell;
+            taken |= 1 << cell;
+            if (Memory_Lines::has_line(marks[side])) {
+                winner = side;
+                over = true;
+            } else if (taken == 0x1FF) {
+                over = true;
+            }
+            side ^= 1;
+        }
+
+        // Each node scores the result for the player who moved into it
+        for (int i = 0; i < depth; i++) {
+            Node& n = nodes[path[i]];
+            n.visits++;
+            int mover = (root_side + i + 1) % 2;
+            if (i > 0) n.score += winner < 0 ? 0.5 : winner == mover ? 1.0 : 0.0;
+        }
+    }
+
+    const Node& root = nodes[0];
+    int best = root.first_child;
+    for (int c = root.first_child; c < root.first_child + root.n_children; c++)
+        if (nodes[c].visits > nodes[best].visits) best = c;
+    best_value = nodes[best].visits ? nodes[best].score / nodes[best].visits : 0;
+    return nodes[best].move;
+}
+
+// ---------------- Memory_Player ----------------
+
+Memory_Player::Memory_Player(string name, char symbol, PlayerType type, const Memory_Recall_Config& recall)
+    : Player<char>(name, symbol, type), memory(recall), engine(Memory_ISMCTS_Config(), game_random().next()) {}
+
+Move<char>* Memory_Player::get_ismcts_move() {
+    Memory_Board* memory_board = static_cast<Memory_Board*>(boardPtr);
+    while (memory.moves() < memory_board->get_n_moves())
+        memory.observe(memory_board->get_move_cell(memory.moves()), game_random());
+
+    int cell = engine.search(memory.occupied(), memory.known_x(), memory.known_o());
+    int x = cell / 3, y = cell % 3;
+    cout << name << " (" << symbol << ") plays (" << x << ", " << y << ") (ISMCTS, expected "
+         << lround(engine.get_best_value() * 100) << "%)\n";
+    return new Move<char>(x, y, symbol);
+}
+
 // ---------------- Memory_UI ----------------
 
 
@@ -61,6 +225,8 @@ Memory_UI::Memory_UI() : UI<char>("Welcome to Memory Tic-Tac-Toe ", 3) {
     cout << "- You must remember where you and your opponent placed symbols\n";
     cout << "- At the end, all moves will be revealed\n";
     cout << "- Win by getting 3 in a row!\n\n";
+    player_type_options = { "Human", "Random Computer", "ISMCTS AI (perfect memory)",
+                            "ISMCTS AI (fading memory)", "ISMCTS AI (remembers the last 3 moves)" };
 }
 
 void Memory_UI::display_board_matrix(const vector<vector<char> > &matrix) const {
@@ -86,20 +252,39 @@ void Memory_UI::display_board_matrix(const vector<vector<char> > &matrix) const
     cout << endl;
 }
 
+PlayerType Memory_UI::get_player_type_choice(string player_label, const vector<string>& options) {
+    cout << "Choose " << player_label << " type:\n";
+    for (size_t i = 0; i < options.size(); ++i)
+        cout << i + 1 << ". " << options[i] << "\n";
+    int choice;
+    cin >> choice;
+
+    recall = Memory_Recall_Config();
+    if (choice == 4) recall.retention = 0.9;
+    else if (choice == 5) recall.window = 3;
+
+    if (choice == 2) return PlayerType::COMPUTER;
+    if (choice >= 3 && choice <= 5) return PlayerType::AI;
+    return PlayerType::HUMAN;
+}
+
 Player<char>* Memory_UI::create_player(string& name, char symbol, PlayerType type) {
-    return new Player<char>(name, symbol, type);
+    return new Memory_Player(name, symbol, type, recall);
 }
 
 Move<char>* Memory_UI::get_move(Player<char>* player) {
     int x, y;
+    if (player->get_type() == PlayerType::AI) {
+        return static_cast<Memory_Player*>(player)->get_ismcts_move();
+    }
     if (player->get_type() == PlayerType::HUMAN) {
         cout << "\n" << player->get_name() << " (" << player->get_symbol()
              << "), enter your move x y (0-2): ";
         cin >> x >> y;
     }
     else {
-        x = rand() % 3;
-        y = rand() % 3;
+        x = game_random().below(3);
+        y = game_random().below(3);
     }
     return new Move<char>(x, y, player->get_symbol());
 }
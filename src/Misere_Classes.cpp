@@ -1,24 +1,12 @@
 #include "Misere_Classes.h"
+#include "Misere_Table.h"
 #include <iostream>
 #include <iomanip>
-#include <cstdlib> // for rand()
+#include "Game_Random.h"
+#include <algorithm>
 
 using namespace std;
 
-/**
- * @brief Helper function to check if three symbols are equal and not blank.
- *
- * @param a First symbol
- * @param b Second symbol
- * @param c Third symbol
- * @param blank Character representing blank
- * @return true if all three symbols are equal and not blank
- * @return false otherwise
- */
-static inline bool three_eq(char a, char b, char c, char blank) {
-    return (a == b && b == c && a != blank);
-}
-
 // ---------------- Misere_TTT_Board ----------------
 
 /**
@@ -74,22 +62,7 @@ bool Misere_TTT_Board::update_board(Move<char>* move) {
 bool Misere_TTT_Board::is_lose(Player<char>* player) {
     if (!player) return false;
     char sym = toupper(player->get_symbol());
-
-    // rows & cols
-    for (int i = 0; i < rows; ++i) {
-        if (three_eq(board[i][0], board[i][1], board[i][2], blank_symbol) && board[i][0] == sym)
-            return true;
-        if (three_eq(board[0][i], board[1][i], board[2][i], blank_symbol) && board[0][i] == sym)
-            return true;
-    }
-
-    // diagonals
-    if (three_eq(board[0][0], board[1][1], board[2][2], blank_symbol) && board[1][1] == sym)
-        return true;
-    if (three_eq(board[0][2], board[1][1], board[2][0], blank_symbol) && board[1][1] == sym)
-        return true;
-
-    return false;
+    return Misere_Lines::has_line(Misere_Lines::marks_of(board, sym));
 }
 
 /**
@@ -103,22 +76,7 @@ bool Misere_TTT_Board::is_win(Player<char>* player) {
     if (!player) return false;
     char sym = toupper(player->get_symbol());
     char opp = (sym == 'X') ? 'O' : 'X';
-
-    // rows & cols
-    for (int i = 0; i < rows; ++i) {
-        if (three_eq(board[i][0], board[i][1], board[i][2], blank_symbol) && board[i][0] == opp)
-            return true;
-        if (three_eq(board[0][i], board[1][i], board[2][i], blank_symbol) && board[0][i] == opp)
-            return true;
-    }
-
-    // diagonals
-    if (three_eq(board[0][0], board[1][1], board[2][2], blank_symbol) && board[1][1] == opp)
-        return true;
-    if (three_eq(board[0][2], board[1][1], board[2][0], blank_symbol) && board[1][1] == opp)
-        return true;
-
-    return false;
+    return Misere_Lines::has_line(Misere_Lines::marks_of(board, opp));
 }
 
 /**
@@ -128,13 +86,8 @@ bool Misere_TTT_Board::is_win(Player<char>* player) {
  * @return false otherwise
  */
 bool Misere_TTT_Board::any_three_in_row() const {
-    for (int i = 0; i < rows; ++i) {
-        if (three_eq(board[i][0], board[i][1], board[i][2], blank_symbol)) return true;
-        if (three_eq(board[0][i], board[1][i], board[2][i], blank_symbol)) return true;
-    }
-    if (three_eq(board[0][0], board[1][1], board[2][2], blank_symbol)) return true;
-    if (three_eq(board[0][2], board[1][1], board[2][0], blank_symbol)) return true;
-    return false;
+    return Misere_Lines::has_line(Misere_Lines::marks_of(board, 'X')) ||
+           Misere_Lines::has_line(Misere_Lines::marks_of(board, 'O'));
 }
 
 /**
@@ -165,20 +118,46 @@ bool Misere_TTT_Board::game_is_over(Player<char>* player) {
     return any_three_in_row() || (n_moves == rows * columns);
 }
 
+// ---------------- Misere_Solver ----------------
+
+/**
+ * @brief Look up perfect play in the precomputed table.
+ *
+ * @param board 3x3 board with X having moved first
+ * @param cell Receives the best move as row * 3 + col
+ * @param result Receives the result for the player to move
+ * @return true if the position is in the table
+ * @return false if it is unreachable or already over
+ */
+bool Misere_Solver::lookup(const vector<vector<char>>& board, int& cell, Result& result) {
+    int symmetry;
+    uint32_t key = uint32_t(canonicalize(encode(board), symmetry));
+
+    const uint32_t* end = MISERE_TABLE + MISERE_TABLE_SIZE;
+    const uint32_t* entry = lower_bound(MISERE_TABLE, end, key << 8);
+    if (entry == end || (*entry >> 8) != key) return false;
+
+    cell = source_cell(symmetry, int(*entry & 0xF));
+    result = Result((*entry >> 4) & 0x3);
+    return true;
+}
+
 // ---------------- Misere_UI ----------------
 
 /**
  * @brief Constructor for Misre Tic-Tac-Toe UI.
  * Sets the game title and board size.
  */
-Misere_UI::Misere_UI() : UI<char>("Welcome to FCAI Misere Tic-Tac-Toe", 3) {}
+Misere_UI::Misere_UI() : UI<char>("Welcome to FCAI Misere Tic-Tac-Toe", 3) {
+    player_type_options = { "Human", "Random Computer", "Perfect AI (Solver)" };
+}
 
 /**
  * @brief Create a new player (human or computer).
  *
  * @param name Player's name
  * @param symbol Player's symbol (X or O)
- * @param type Player type (HUMAN or COMPUTER)
+ * @param type Player type (HUMAN, COMPUTER or AI)
  * @return Player<char>* Pointer to the created player
  */
 Player<char>* Misere_UI::create_player(string& name, char symbol, PlayerType type) {
@@ -189,21 +168,41 @@ Player<char>* Misere_UI::create_player(string& name, char symbol, PlayerType typ
 
 /**
  * @brief Get a move from the player.
- * For human: ask for input. For computer: choose random move.
+ * For human: ask for input. For computer: choose a random empty cell.
+ * For AI: look up the perfect move.
  *
  * @param player Pointer to Player object
  * @return Move<char>* Pointer to the move
  */
 Move<char>* Misere_UI::get_move(Player<char>* player) {
-    int x, y;
+    int x = -1, y = -1;
     if (player->get_type() == PlayerType::HUMAN) {
         cout << "\nPlease enter your move x and y (0 to 2): ";
         cin >> x >> y;
+        return new Move<char>(x, y, player->get_symbol());
+    }
+
+    vector<vector<char>> matrix = player->get_board_ptr()->get_board_matrix();
+    int cell;
+    Misere_Solver::Result result;
+    if (player->get_type() == PlayerType::AI && Misere_Solver::lookup(matrix, cell, result)) {
+        const char* outcome[3] = { "loses", "draws", "wins" };
+        x = cell / 3;
+        y = cell % 3;
+        cout << player->get_name() << " plays (" << x << ", " << y << ") - perfect play "
+             << outcome[result] << "\n";
+        return new Move<char>(x, y, player->get_symbol());
     }
-    else {
-        Board<char>* b = player->get_board_ptr();
-        x = rand() % b->get_rows();
-        y = rand() % b->get_columns();
+
+    int empty_cells[9];
+    int count = 0;
+    for (int i = 0; i < 9; i++)
+        if (matrix[i / 3][i % 3] == '.')
+            empty_cells[count++] = i;
+    if (count > 0) {
+        cell = empty_cells[game_random().below(count)];
+        x = cell / 3;
+        y = cell % 3;
     }
     return new Move<char>(x, y, player->get_symbol());
 }
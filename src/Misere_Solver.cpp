@@ -0,0 +1,74 @@
+#include "Misere_Classes.h"
+#include <cctype>
+
+using namespace std;
+
+// ---------------- Misere_Solver ----------------
+
+/// Powers of 3 giving each cell's weight in the board index
+static const int POW3[9] = { 1, 3, 9, 27, 81, 243, 729, 2187, 6561 };
+
+/// For each symmetry, the original cell that lands on each cell of the image
+static const int SYMMETRY_SOURCE[Misere_Solver::SYMMETRIES][9] = {
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8 },  // identity
+    { 6, 3, 0, 7, 4, 1, 8, 5, 2 },  // rotate 90
+    { 8, 7, 6, 5, 4, 3, 2, 1, 0 },  // rotate 180
+    { 2, 5, 8, 1, 4, 7, 0, 3, 6 },  // rotate 270
+    { 2, 1, 0, 5, 4, 3, 8, 7, 6 },  // mirror columns
+    { 6, 7, 8, 3, 4, 5, 0, 1, 2 },  // mirror rows
+    { 0, 3, 6, 1, 4, 7, 2, 5, 8 },  // main diagonal
+    { 8, 5, 2, 7, 4, 1, 6, 3, 0 }   // anti-diagonal
+};
+
+/**
+ * @brief Cell that a symmetry moves to a given cell of the image.
+ *
+ * @param symmetry Symmetry index in 0..7
+ * @param cell Cell of the transformed board
+ * @return Cell of the original board
+ */
+int Misere_Solver::source_cell(int symmetry, int cell) {
+    return SYMMETRY_SOURCE[symmetry][cell];
+}
+
+/**
+ * @brief Base-3 index of a board (1 for 'X', 2 for 'O').
+ *
+ * @param board 3x3 board
+ * @return Index in 0..3^9-1
+ */
+int Misere_Solver::encode(const vector<vector<char>>& board) {
+    int index = 0;
+    for (int cell = 0; cell < 9; cell++) {
+        char mark = toupper(board[cell / 3][cell % 3]);
+        if (mark == 'X') index += POW3[cell];
+        else if (mark == 'O') index += 2 * POW3[cell];
+    }
+    return index;
+}
+
+/**
+ * @brief Smallest index among the symmetric images of a board.
+ *
+ * @param index Base-3 index of the board
+ * @param symmetry Receives the symmetry giving the smallest index
+ * @return Canonical index
+ */
+int Misere_Solver::canonicalize(int index, int& symmetry) {
+    int digits[9];
+    for (int cell = 0, rest = index; cell < 9; cell++, rest /= 3)
+        digits[cell] = rest % 3;
+
+    int best = index;
+    symmetry = 0;
+    for (int s = 1; s < SYMMETRIES; s++) {
+        int image = 0;
+        for (int cell = 0; cell < 9; cell++)
+            image += digits[SYMMETRY_SOURCE[s][cell]] * POW3[cell];
+        if (image < best) {
+            best = image;
+            symmetry = s;
+        }
+    }
+    return best;
+}
@@ -1,11 +1,136 @@
 #include "NumericalTicTacToe.h"
 #include <iostream>
-#include <cstdlib>
-#include <ctime>
+#include "Game_Random.h"
 #include <algorithm>
+#include <climits>
 
 using namespace std;
 
+/// Cells of the rows, columns and diagonals
+static const int NUMERICAL_LINES[8][3] = {
+    { 0, 1, 2 }, { 3, 4, 5 }, { 6, 7, 8 },
+    { 0, 3, 6 }, { 1, 4, 7 }, { 2, 5, 8 },
+    { 0, 4, 8 }, { 2, 4, 6 }
+};
+
+/// For each symmetry of the square, the cell that lands on each cell of the image
+static const int NUMERICAL_SYMMETRY[8][9] = {
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8 }, { 6, 3, 0, 7, 4, 1, 8, 5, 2 },
+    { 8, 7, 6, 5, 4, 3, 2, 1, 0 }, { 2, 5, 8, 1, 4, 7, 0, 3, 6 },
+    { 2, 1, 0, 5, 4, 3, 8, 7, 6 }, { 6, 7, 8, 3, 4, 5, 0, 1, 2 },
+    { 0, 3, 6, 1, 4, 7, 2, 5, 8 }, { 8, 5, 2, 7, 4, 1, 6, 3, 0 }
+};
+
+/// Number in a cell of a packed state (0 if empty)
+static inline int cell_number(uint64_t state, int cell) {
+    return int(state >> (4 * cell)) & 0xF;
+}
+
+/// True if placing `number` on the empty `cell` completes a line summing to 15
+static bool completes_15(uint64_t state, int cell, int number) {
+    for (const auto& line : NUMERICAL_LINES) {
+        if (line[0] != cell && line[1] != cell && line[2] != cell) continue;
+        int sum = number;
+        bool full = true;
+        for (int c : line) {
+            if (c == cell) continue;
+            int value = cell_number(state, c);
+            if (value == 0) full = false;
+            sum += value;
+        }
+        if (full && sum == 15) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Visit every move of the player to move, best first if it wins at once
+ * @details Calls visit(cell, number, immediate_score) for each move, where
+ *          immediate_score is the score if the move wins or ends the game in a
+ *          draw and INT8_MIN otherwise. Stops when visit returns false.
+ */
+template <typename Visit>
+static void for_each_move(uint64_t state, Visit visit) {
+    uint16_t used = 0;
+    int filled = 0;
+    int odd_placed = 0;
+    for (int cell = 0; cell < 9; cell++) {
+        int value = cell_number(state, cell);
+        if (value == 0) continue;
+        used |= uint16_t(1u << value);
+        filled++;
+        odd_placed += value & 1;
+    }
+    int parity = (odd_placed == filled - odd_placed) ? 1 : 0;  // odd moves first
+
+    for (int cell = 0; cell < 9; cell++) {
+        if (cell_number(state, cell) != 0) continue;
+        for (int number = 2 - parity; number <= 9; number += 2) {
+            if (used >> number & 1) continue;
+            int immediate = completes_15(state, cell, number) ? 10 - filled
+                          : filled == 8 ? 0 : INT8_MIN;
+            if (!visit(cell, number, immediate)) return;
+        }
+    }
+}
+
+unordered_map<uint64_t, int8_t>& NumericalSolver::memo() {
+    static unordered_map<uint64_t, int8_t> table = [] {
+        unordered_map<uint64_t, int8_t> empty;
+        empty.reserve(1 << 20);  // a full solve stores about 800k positions
+        return empty;
+    }();
+    return table;
+}
+
+uint64_t NumericalSolver::canonical(uint64_t state) {
+    uint64_t best = state;
+    for (int s = 1; s < 8; s++) {
+        uint64_t image = 0;
+        for (int cell = 0; cell < 9; cell++)
+            image |= uint64_t(cell_number(state, NUMERICAL_SYMMETRY[s][cell])) << (4 * cell);
+        if (image < best) best = image;
+    }
+    return best;
+}
+
+int NumericalSolver::score(uint64_t state) {
+    uint64_t key = canonical(state);
+    auto it = memo().find(key);
+    if (it != memo().end()) return it->second;
+
+    int best = INT8_MIN;
+    for_each_move(state, [&](int cell, int number, int immediate) {
+        int value = immediate != INT8_MIN ? immediate
+                  : -score(state | uint64_t(number) << (4 * cell));
+        if (value > best) best = value;
+        return immediate <= 0;  // no move beats an immediate win
+    });
+    memo()[key] = int8_t(best);
+    return best;
+}
+
+int NumericalSolver::best_move(uint64_t state, int& cell, int& number) {
+    int best = INT8_MIN;
+    cell = -1;
+    number = 0;
+    for_each_move(state, [&](int c, int n, int immediate) {
+        int value = immediate != INT8_MIN ? immediate
+                  : -score(state | uint64_t(n) << (4 * c));
+        if (value > best) {
+            best = value;
+            cell = c;
+            number = n;
+        }
+        return true;
+    });
+    return best;
+}
+
+size_t NumericalSolver::solved_positions() {
+    return memo().size();
+}
+
 
 NumericalBoard::NumericalBoard() : Board<int>(3, 3) {
     for (int i = 0; i < 3; i++) {
@@ -13,7 +138,6 @@ NumericalBoard::NumericalBoard() : Board<int>(3, 3) {
             board[i][j] = blank;
         }
     }
-    srand(static_cast<unsigned>(time(0)));
 }
 
 bool NumericalBoard::check_sum_15(int a, int b, int c) {
@@ -41,15 +165,11 @@ bool NumericalBoard::update_board(Move<int>* move) {
         return false;
     }
 
-    if (currentMoveIsOdd) {
-        if (used_numbers_odd.count(num)) return false;
-        used_numbers_odd.insert(num);
-    } else {
-        if (used_numbers_even.count(num)) return false;
-        used_numbers_even.insert(num);
-    }
+    if (num < 1 || num > 9 || is_number_used(num, currentMoveIsOdd)) return false;
+    used_numbers |= uint16_t(1u << num);
 
     board[x][y] = num;
+    state |= uint64_t(num) << (4 * (x * 3 + y));
     n_moves++;
     return true;
 }
@@ -95,11 +215,9 @@ bool NumericalBoard::game_is_over(Player<int>* player) {
 }
 
 bool NumericalBoard::is_number_used(int num, bool isOdd) {
-    if (isOdd) {
-        return used_numbers_odd.count(num) > 0;
-    } else {
-        return used_numbers_even.count(num) > 0;
-    }
+    // Each pool only ever holds numbers of its own parity
+    if (num < 0 || num > 9 || (num % 2 == 1) != isOdd) return false;
+    return (used_numbers >> num) & 1;
 }
 
 NumericalPlayer::NumericalPlayer(string n, int s, PlayerType t, bool oddPlayer)
@@ -156,7 +274,7 @@ Move<int>* NumericalPlayer::get_random_move() {
         cout << name << " has no available numbers left!\n";
         return nullptr;
     }
-    chosen_number = available[rand() % available.size()];
+    chosen_number = available[game_random().below(available.size())];
 
     vector<Move<int>*> moves = get_valid_moves();
 
@@ -165,7 +283,7 @@ Move<int>* NumericalPlayer::get_random_move() {
         return nullptr;
     }
 
-    int random_index = rand() % moves.size();
+    int random_index = game_random().below(moves.size());
     Move<int>* chosen = moves[random_index];
 
     // Clean up other moves
@@ -178,6 +296,21 @@ Move<int>* NumericalPlayer::get_random_move() {
     return chosen;
 }
 
+Move<int>* NumericalPlayer::get_perfect_move() {
+    NumericalBoard* numBoard = static_cast<NumericalBoard*>(this->boardPtr);
+    int cell, number;
+    int score = NumericalSolver::best_move(numBoard->get_state(), cell, number);
+    if (cell < 0) {
+        cout << name << " has no valid moves left!\n";
+        return nullptr;
+    }
+
+    chosen_number = number;
+    cout << name << " places '" << chosen_number << "' at (" << cell / 3 << ", " << cell % 3
+         << ") (perfect play " << (score > 0 ? "wins" : score < 0 ? "loses" : "draws") << ")\n";
+    return new Move<int>(cell / 3, cell % 3, chosen_number);
+}
+
 NumericalUI::NumericalUI() : UI<int>("Numerical Tic-Tac-Toe - Make lines sum to 15!", 3) {
     cout << "\nRules:\n";
     cout << "- Player 1 uses odd numbers (1,3,5,7,9)\n";
@@ -186,6 +319,7 @@ NumericalUI::NumericalUI() : UI<int>("Numerical Tic-Tac-Toe - Make lines sum to
     cout << "- Each number can only be used once\n";
     cout << "- Win by forming a line (row, column, or diagonal) that sums to 15\n";
     cout << "- If all cells are filled without a winner, it's a draw!\n\n";
+    player_type_options = { "Human", "Random Computer", "Perfect AI (Solver)" };
 }
 
 Player<int>* NumericalUI::create_player(string& name, int symbol, PlayerType type) {
@@ -205,6 +339,9 @@ Move<int>* NumericalUI::get_move(Player<int>* player)
     if (player->get_type() == PlayerType::COMPUTER)
         return np->get_random_move();
 
+    if (player->get_type() == PlayerType::AI)
+        return np->get_perfect_move();
+
     vector<int> available = np->get_available_numbers();
 
     if (available.empty()) {
@@ -1,18 +1,100 @@
 ﻿#include "Pyramid_Classes.h"
+#include <bit>
 #include <iostream>
-#include <cstdlib>
-#include <ctime>
+#include "Game_Random.h"
 using namespace std;
 
+/// Playable cells: 1, 3 and 5 cells centred on a 3x5 grid
+static constexpr const char* PYRAMID_SHAPE[3] = {
+    "##.##",
+    "#...#",
+    "....."
+};
+
+static constexpr Board_Geometry<3, 5> PYRAMID_GEOMETRY(PYRAMID_SHAPE);
+
+/// All 7 winning triples: 4 horizontal, 1 vertical and 2 diagonal
+static constexpr auto PYRAMID_LINES = PYRAMID_GEOMETRY.lines(3);
+
+//-------------------------------- Pyramid_Solver --------------------------------
+
+static constexpr int POW3[10] = { 1, 3, 9, 27, 81, 243, 729, 2187, 6561, 19683 };
+
+/**
+ * @brief Check whether a set of dense cells contains a winning line.
+ */
+static bool has_line(uint64_t cells) {
+    for (int i = 0; i < PYRAMID_LINES.count; i++)
+        if ((cells & PYRAMID_LINES[i]) == PYRAMID_LINES[i])
+            return true;
+    return false;
+}
+
+/**
+ * @brief Solve every position by negamax, from the highest index down.
+ * @details The positions after each move have higher indices, so they are
+ *          already solved when a position is reached. States with
+ *          impossible mark counts are filled too but never looked up.
+ */
+static array<Pyramid_Solution, Pyramid_Solver::STATES> make_pyramid_table() {
+    array<Pyramid_Solution, Pyramid_Solver::STATES> table{};
+    for (int state = Pyramid_Solver::STATES - 1; state >= 0; state--) {
+        uint64_t marks[2] = { 0, 0 };
+        for (int cell = 0; cell < 9; cell++) {
+            int digit = state / POW3[cell] % 3;
+            if (digit) marks[digit - 1] |= 1ull << cell;
+        }
+
+        int placed = popcount(marks[0] | marks[1]);
+        int mover = placed % 2;
+        int empty = 9 - placed;
+
+        if (has_line(marks[1 - mover])) {
+            table[state] = { int8_t(-(1 + empty)), -1 };
+            continue;
+        }
+        if (empty == 0) {
+            table[state] = { 0, -1 };
+            continue;
+        }
+
+        Pyramid_Solution best = { -128, -1 };
+        for (int cell = 0; cell < 9; cell++) {
+            if (((marks[0] | marks[1]) >> cell) & 1) continue;
+            int value = -table[state + (mover + 1) * POW3[cell]].value;
+            if (value > best.value)
+                best = { int8_t(value), int8_t(cell) };
+        }
+        table[state] = best;
+    }
+    return table;
+}
+
+int Pyramid_Solver::cell_weight(int cell) {
+    return POW3[cell];
+}
+
+const Pyramid_Solution& Pyramid_Solver::lookup(int state) {
+    static const array<Pyramid_Solution, Pyramid_Solver::STATES> table = make_pyramid_table();
+    return table[state];
+}
+
+int Pyramid_Solver::row_of(int cell) {
+    return PYRAMID_GEOMETRY.row_of(cell);
+}
+
+int Pyramid_Solver::col_of(int cell) {
+    return PYRAMID_GEOMETRY.col_of(cell);
+}
+
 //-------------------------------- Pyramid_Board --------------------------------
 
 /**
  * @brief Construct a Pyramid board with 3 rows and 5 columns.
- * Initializes the board and the winning lines.
+ * Initializes the board cells.
  */
 Pyramid_Board::Pyramid_Board() : Board<char>(3, 5) {
     init_board();
-    init_winning_lines();
 }
 
 /**
@@ -21,26 +103,14 @@ Pyramid_Board::Pyramid_Board() : Board<char>(3, 5) {
 void Pyramid_Board::init_board() {
     for (int r = 0; r < rows; r++)
         for (int c = 0; c < columns; c++)
-            board[r][c] = blank_symbol;
-
-    // Mark invalid cells to create the pyramid shape
-    board[0][0] = invalid_blank;
-    board[0][1] = invalid_blank;
-    board[0][3] = invalid_blank;
-    board[0][4] = invalid_blank;
-    board[1][0] = invalid_blank;
-    board[1][4] = invalid_blank;
+            board[r][c] = PYRAMID_GEOMETRY.playable(r, c) ? blank_symbol : invalid_blank;
 }
 
 /**
  * @brief Determine if a cell is part of the playable pyramid area.
  */
 bool Pyramid_Board::is_playable_cell(int x, int y) const {
-    int playable = 1 + 2 * x;       ///< Number of playable cells in the row.
-    int center = columns / 2;       ///< Middle column index.
-    int start = center - (playable / 2);
-    int end = center + (playable / 2);
-    return y >= start && y <= end;
+    return PYRAMID_GEOMETRY.playable(x, y);
 }
 
 /**
@@ -53,48 +123,32 @@ bool Pyramid_Board::update_board(Move<char>* move) {
     if (!is_playable_cell(x, y) || board[x][y] != blank_symbol)
         return false;
 
-    board[x][y] = toupper(move->get_symbol());
+    char mark = toupper(move->get_symbol());
+    int cell = PYRAMID_GEOMETRY.index(x, y);
+    int side = mark == 'X' ? 0 : 1;
+    board[x][y] = mark;
+    stones[side] |= 1ull << cell;
+    state += (side + 1) * Pyramid_Solver::cell_weight(cell);
     n_moves++;
     return true;
 }
 
-/**
- * @brief Initialize all possible winning lines for the pyramid board.
- */
-void Pyramid_Board::init_winning_lines() {
-    winning_lines = {
-        { make_pair(1,1), make_pair(1,2), make_pair(1,3) },
-        { make_pair(2,0), make_pair(2,1), make_pair(2,2) },
-        { make_pair(2,1), make_pair(2,2), make_pair(2,3) },
-        { make_pair(2,2), make_pair(2,3), make_pair(2,4) },
-        { make_pair(0,2), make_pair(1,2), make_pair(2,2) },
-        { make_pair(0,2), make_pair(1,1), make_pair(2,0) },
-        { make_pair(0,2), make_pair(1,3), make_pair(2,4) }
-    };
-}
-
 /**
  * @brief Check if the given player has a winning line.
  */
 bool Pyramid_Board::is_win(Player<char>* player) {
     char sym = player->get_symbol();
-    for (auto& line : winning_lines) {
-        if (board[line[0].first][line[0].second] == sym &&
-            board[line[1].first][line[1].second] == sym &&
-            board[line[2].first][line[2].second] == sym)
-            return true;
-    }
-    return false;
+    if (sym != 'X' && sym != 'O') return false;
+
+    return has_line(stones[sym == 'X' ? 0 : 1]);
 }
 
 /**
  * @brief Check if the game ended in a draw.
  */
 bool Pyramid_Board::is_draw(Player<char>* player) {
-    for (int r = 0; r < rows; r++)
-        for (int c = 0; c < columns; c++)
-            if (is_playable_cell(r, c) && board[r][c] == blank_symbol)
-                return false;
+    if ((stones[0] | stones[1]) != PYRAMID_GEOMETRY.full_mask())
+        return false;
 
     return !is_win(player);
 }
@@ -112,9 +166,8 @@ bool Pyramid_Board::game_is_over(Player<char>* player) {
  * @brief Construct the Pyramid UI and print the welcome message.
  */
 Pyramid_UI::Pyramid_UI()
-    : UI<char>("Welcome to Pyramid Tic-Tac-Toe", 6)
-{
-    srand(static_cast<unsigned int>(time(nullptr)));
+    : UI<char>("Welcome to Pyramid Tic-Tac-Toe", 6) {
+    player_type_options = { "Human", "Random Computer", "Perfect AI (Solver)" };
 }
 
 /**
@@ -125,7 +178,7 @@ Player<char>* Pyramid_UI::create_player(string& name, char symbol, PlayerType ty
 }
 
 /**
- * @brief Get a move from a player (human or AI).
+ * @brief Get a move from a player (human, random computer or perfect AI).
  */
 Move<char>* Pyramid_UI::get_move(Player<char>* player) {
     int x, y;
@@ -136,23 +189,28 @@ Move<char>* Pyramid_UI::get_move(Player<char>* player) {
             cin >> x >> y;
         } while (x < 0 || x > 2 || y < 0 || y > 4);
     }
+    else if (player->get_type() == PlayerType::AI) {
+        Pyramid_Board* board = dynamic_cast<Pyramid_Board*>(player->get_board_ptr());
+        const Pyramid_Solution& best = Pyramid_Solver::lookup(board->get_state());
+        x = best.cell < 0 ? 0 : Pyramid_Solver::row_of(best.cell);
+        y = best.cell < 0 ? 0 : Pyramid_Solver::col_of(best.cell);
+
+        const char* outcome = best.value > 0 ? "win" : best.value < 0 ? "loss" : "draw";
+        cout << "Computer played: (" << x << ", " << y << ") (perfect play, " << outcome << ")\n";
+    }
     else {
         auto b = player->get_board_ptr()->get_board_matrix();
         vector<pair<int, int>> empty;
 
-        for (int r = 0; r < 3; r++) {
-            int playable = 1 + r * 2;
-            int center = 2;
-            int start = center - (playable / 2);
-            int end = center + (playable / 2);
-
-            for (int c = start; c <= end; c++)
-                if (b[r][c] == '.')
-                    empty.push_back({ r, c });
+        for (int cell = 0; cell < PYRAMID_GEOMETRY.size(); cell++) {
+            int r = PYRAMID_GEOMETRY.row_of(cell);
+            int c = PYRAMID_GEOMETRY.col_of(cell);
+            if (b[r][c] == '.')
+                empty.push_back({ r, c });
         }
 
         if (!empty.empty()) {
-            int k = rand() % empty.size();
+            int k = game_random().below(empty.size());
             x = empty[k].first;
             y = empty[k].second;
         }
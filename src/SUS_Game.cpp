@@ -5,12 +5,86 @@
 
 #include "SUS_Game.h"
 #include <iostream>
-#include <cstdlib>
-#include <ctime>
-#include <cmath>
+#include "Game_Random.h"
+#include <array>
 
 using namespace std;
 
+/** @brief Powers of 3 giving each cell's weight in the board index */
+static constexpr int POW3[9] = { 1, 3, 9, 27, 81, 243, 729, 2187, 6561 };
+
+/** @brief Rows, columns and diagonals as cells, in reading order */
+static constexpr int SUS_LINES[8][3] = {
+    { 0, 1, 2 }, { 3, 4, 5 }, { 6, 7, 8 },
+    { 0, 3, 6 }, { 1, 4, 7 }, { 2, 5, 8 },
+    { 0, 4, 8 }, { 2, 4, 6 }
+};
+
+/** @brief Number of lines through each cell */
+static constexpr int CELL_LINE_COUNT[9] = { 3, 2, 3, 2, 4, 2, 3, 2, 3 };
+
+/** @brief Indices into SUS_LINES of the lines through each cell */
+static constexpr int CELL_LINES[9][4] = {
+    { 0, 3, 6 }, { 0, 4 }, { 0, 5, 7 },
+    { 1, 3 }, { 1, 4, 6, 7 }, { 1, 5 },
+    { 2, 3, 7 }, { 2, 4 }, { 2, 5, 6 }
+};
+
+/**
+ * @brief Points scored by placing a letter on an empty cell
+ * @param state Board index before the move
+ * @param cell Empty cell as row * 3 + col
+ * @param digit Letter as a base-3 digit (1 'S', 2 'U')
+ * @return Number of S-U-S lines the move completes
+ */
+static int sus_gain(int state, int cell, int digit) {
+    int after = state + digit * POW3[cell];
+    int gained = 0;
+    for (int i = 0; i < CELL_LINE_COUNT[cell]; i++) {
+        const int* line = SUS_LINES[CELL_LINES[cell][i]];
+        if (after / POW3[line[0]] % 3 == 1 && after / POW3[line[1]] % 3 == 2 &&
+            after / POW3[line[2]] % 3 == 1)
+            gained++;
+    }
+    return gained;
+}
+
+/**
+ * @brief Solve every board by negamax over the final point margin
+ * @details Boards are visited from the highest index down, so the boards
+ *          after every move are solved first. About 120k move evaluations,
+ *          well past what compilers allow for constant evaluation, so the
+ *          table is built on first use instead.
+ */
+static array<SUS_Solution, SUS_Solver::STATES> make_sus_table() {
+    array<SUS_Solution, SUS_Solver::STATES> table{};
+    for (int state = SUS_Solver::STATES - 1; state >= 0; state--) {
+        SUS_Solution best = { 0, 9, '.' };
+        bool found = false;
+        for (int cell = 0; cell < 9; cell++) {
+            if (state / POW3[cell] % 3 != 0) continue;
+            for (int digit = 1; digit <= 2; digit++) {
+                int value = sus_gain(state, cell, digit) - table[state + digit * POW3[cell]].value;
+                if (!found || value > best.value) {
+                    best = { int8_t(value), uint8_t(cell), digit == 1 ? 'S' : 'U' };
+                    found = true;
+                }
+            }
+        }
+        table[state] = best;
+    }
+    return table;
+}
+
+int SUS_Solver::cell_weight(int cell) {
+    return POW3[cell];
+}
+
+const SUS_Solution& SUS_Solver::lookup(int state) {
+    static const array<SUS_Solution, SUS_Solver::STATES> table = make_sus_table();
+    return table[state];
+}
+
 
 SUS_Board::SUS_Board() : Board(3, 3), last_player('X') {
     for (int i = 0; i < 3; i++) {
@@ -18,7 +92,6 @@ SUS_Board::SUS_Board() : Board(3, 3), last_player('X') {
             board[i][j] = blank;
         }
     }
-    srand(static_cast<unsigned>(time(0)));
 }
 
 bool SUS_Board::update_board(Move<char>* move) {
@@ -32,63 +105,57 @@ bool SUS_Board::update_board(Move<char>* move) {
 
     if (letter != 'S' && letter != 'U') return false;
 
-    // Place letter
-    board[x][y] = letter;
-    n_moves++;
+    int gained = make_move(x, y, letter);
 
     last_player = (n_moves % 2 == 1) ? 'X' : 'O';
 
-    check_and_count_sus(last_player);
+    if (gained > 0) {
+        if (last_player == 'X') {
+            cout << "Player X formed " << gained << " new S-U-S! Total score: " << score_X << "\n";
+        } else {
+            cout << "Player O formed " << gained << " new S-U-S! Total score: " << score_O << "\n";
+        }
+    }
+
+    cout << "Total S-U-S sequences on board: " << Total_SUS << "\n";
 
     return true;
 }
 
-int SUS_Board::count_total_sus() {
+int SUS_Board::count_sus_through(int x, int y) const {
+    int cell = x * 3 + y;
     int count = 0;
-
-    // Check horizontal S-U-S
-    for (int i = 0; i < 3; i++) {
-        if (board[i][0] == 'S' && board[i][1] == 'U' && board[i][2] == 'S') {
-            count++;
-        }
-    }
-
-    // Check vertical S-U-S
-    for (int j = 0; j < 3; j++) {
-        if (board[0][j] == 'S' && board[1][j] == 'U' && board[2][j] == 'S') {
+    for (int i = 0; i < CELL_LINE_COUNT[cell]; i++) {
+        const int* line = SUS_LINES[CELL_LINES[cell][i]];
+        if (board[line[0] / 3][line[0] % 3] == 'S' && board[line[1] / 3][line[1] % 3] == 'U' &&
+            board[line[2] / 3][line[2] % 3] == 'S')
             count++;
-        }
-    }
-
-    // Check main diagonal S-U-S
-    if (board[0][0] == 'S' && board[1][1] == 'U' && board[2][2] == 'S') {
-        count++;
     }
-
-    // Check anti-diagonal S-U-S
-    if (board[0][2] == 'S' && board[1][1] == 'U' && board[2][0] == 'S') {
-        count++;
-    }
-
     return count;
 }
 
-void SUS_Board::check_and_count_sus(char player_symbol) {
-    int total_now = count_total_sus();
-    int gained = abs(total_now - Total_SUS);
+int SUS_Board::make_move(int x, int y, char letter) {
+    board[x][y] = letter;
+    state += SUS_Solver::letter_digit(letter) * SUS_Solver::cell_weight(x * 3 + y);
+    n_moves++;
+
+    // The cell was empty, so every complete line through it is new
+    int gained = count_sus_through(x, y);
+    if (n_moves % 2 == 1) score_X += gained;
+    else score_O += gained;
+    Total_SUS += gained;
+    return gained;
+}
 
-    if (gained > 0) {
-        if (player_symbol == 'X') {
-            score_X += gained;
-            cout << "Player X formed " << gained << " new S-U-S! Total score: " << score_X << "\n";
-        } else {
-            score_O += gained;
-            cout << "Player O formed " << gained << " new S-U-S! Total score: " << score_O << "\n";
-        }
-        Total_SUS = total_now;
-    }
+void SUS_Board::unmake_move(int x, int y) {
+    int lost = count_sus_through(x, y);
+    if (n_moves % 2 == 1) score_X -= lost;
+    else score_O -= lost;
+    Total_SUS -= lost;
 
-    cout << "Total S-U-S sequences on board: " << Total_SUS << "\n";
+    state -= SUS_Solver::letter_digit(board[x][y]) * SUS_Solver::cell_weight(x * 3 + y);
+    board[x][y] = blank;
+    n_moves--;
 }
 
 bool SUS_Board::is_win(Player<char>* player) {
@@ -152,12 +219,12 @@ vector<Move<char>*> SUS_Player::get_valid_moves() {
 
 Move<char>* SUS_Player::get_random_move() {
     // Randomly choose S or U
-    chosen_letter = (rand() % 2 == 0) ? 'S' : 'U';
+    chosen_letter = game_random().below(2) == 0 ? 'S' : 'U';
 
     vector<Move<char>*> moves = get_valid_moves();
 
     if (!moves.empty()) {
-        int random_index = rand() % moves.size();
+        int random_index = game_random().below(moves.size());
         Move<char>* chosen = moves[random_index];
 
         // Clean up other moves
@@ -173,6 +240,19 @@ Move<char>* SUS_Player::get_random_move() {
     return nullptr;
 }
 
+Move<char>* SUS_Player::get_perfect_move() {
+    SUS_Board* sus_board = dynamic_cast<SUS_Board*>(boardPtr);
+    const SUS_Solution& best = SUS_Solver::lookup(sus_board->get_state());
+    if (best.cell > 8) return nullptr;
+
+    chosen_letter = best.letter;
+    int x = best.cell / 3;
+    int y = best.cell % 3;
+    cout << name << " places '" << chosen_letter << "' at (" << x << ", " << y
+         << ") (perfect play, margin " << (best.value >= 0 ? "+" : "") << int(best.value) << ")\n";
+    return new Move<char>(x, y, chosen_letter);
+}
+
 
 SUS_UI::SUS_UI() : UI<char>("SUS Game - Form S-U-S sequences to win!", 3) {
     cout << "\n             SUS GAME                        \n";
@@ -182,6 +262,7 @@ SUS_UI::SUS_UI() : UI<char>("SUS Game - Form S-U-S sequences to win!", 3) {
     cout << "- Score points by forming 'S-U-S' sequences\n";
     cout << "- Sequences can be horizontal, vertical, or diagonal\n";
     cout << "- Player with most sequences wins when board is full!\n\n";
+    player_type_options = { "Human", "Random Computer", "Perfect AI (Solver)" };
 }
 
 Player<char>* SUS_UI::create_player(string& name, char symbol, PlayerType type) {
@@ -195,6 +276,10 @@ Move<char>* SUS_UI::get_move(Player<char>* player) {
         return sus_player->get_random_move();
     }
 
+    if (player->get_type() == PlayerType::AI) {
+        return sus_player->get_perfect_move();
+    }
+
     // Human player
     int x, y;
     char letter;
@@ -7,6 +7,10 @@
  */
 
 #include "UltimateTicTacToe.h"
+#include "Game_Random.h"
+#include <cmath>
+#include <thread>
+#include <algorithm>
 
 // ============================================================================
 // Ultimate_TTT_Board Implementation
@@ -19,83 +23,45 @@
  */
 template <typename T>
 Ultimate_TTT_Board<T>::Ultimate_TTT_Board() : Board<T>(9, 9) {
-    sub_boards.resize(3, vector<vector<T>>(3, vector<T>(9, T())));
-    main_board.resize(3, vector<T>(3, T()));
-    sub_board_won.resize(3, vector<bool>(3, false));
-    active_sub_board_x = -1;
-    active_sub_board_y = -1;
-    first_move = true;
+    side_symbols[0] = T();
+    side_symbols[1] = T();
+    n_sides = 0;
 }
 
 /**
- * @brief Check if a 3x3 grid has three in a row
- * @param grid The 3x3 grid to check
- * @param symbol The player symbol to check for
- * @return true if player has won this grid
+ * @brief Map a player symbol to its bitboard side
+ * @param symbol The player symbol
+ * @return Side index (0 or 1); the first symbol to play becomes side 0
  */
 template <typename T>
-bool Ultimate_TTT_Board<T>::check_win_in_grid(const vector<vector<T>>& grid, T symbol) {
-    // Check rows and columns
-    for (int i = 0; i < 3; i++) {
-        if (grid[i][0] == symbol && grid[i][1] == symbol && grid[i][2] == symbol)
-            return true;
-        if (grid[0][i] == symbol && grid[1][i] == symbol && grid[2][i] == symbol)
-            return true;
+int Ultimate_TTT_Board<T>::side_of(T symbol) {
+    int side = find_side(symbol);
+    if (side == -1 && n_sides < 2) {
+        side = n_sides++;
+        side_symbols[side] = symbol;
     }
-    // Check diagonals
-    if (grid[0][0] == symbol && grid[1][1] == symbol && grid[2][2] == symbol)
-        return true;
-    if (grid[0][2] == symbol && grid[1][1] == symbol && grid[2][0] == symbol)
-        return true;
-    return false;
-}
-
-/**
- * @brief Check if a sub-board is completely filled
- * @param sub_x Sub-board row index (0-2)
- * @param sub_y Sub-board column index (0-2)
- * @return true if all cells in the sub-board are occupied
- */
-template <typename T>
-bool Ultimate_TTT_Board<T>::is_sub_board_full(int sub_x, int sub_y) {
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 3; j++) {
-            if (sub_boards[sub_x][sub_y][i * 3 + j] == T())
-                return false;
-        }
-    }
-    return true;
+    return side;
 }
 
 /**
- * @brief Update main board if a sub-board has been won
- * @param sub_x Sub-board row index (0-2)
- * @param sub_y Sub-board column index (0-2)
- * @param symbol The player symbol that might have won
+ * @brief Look up the bitboard side of a symbol
+ * @param symbol The player symbol
+ * @return Side index, or -1 if the symbol has not played yet
  */
 template <typename T>
-void Ultimate_TTT_Board<T>::update_main_board_if_won(int sub_x, int sub_y, T symbol) {
-    if (sub_board_won[sub_x][sub_y])
-        return;
-
-    vector<vector<T>> temp_grid(3, vector<T>(3));
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 3; j++) {
-            temp_grid[i][j] = sub_boards[sub_x][sub_y][i * 3 + j];
-        }
-    }
-
-    if (check_win_in_grid(temp_grid, symbol)) {
-        main_board[sub_x][sub_y] = symbol;
-        sub_board_won[sub_x][sub_y] = true;
+int Ultimate_TTT_Board<T>::find_side(T symbol) const {
+    for (int i = 0; i < n_sides; i++) {
+        if (side_symbols[i] == symbol)
+            return i;
     }
+    return -1;
 }
 
 /**
  * @brief Update the board with a player's move
  * @param move Pointer to move object containing position and symbol
  * @return true if move is valid and successfully applied, false otherwise
- * @details Validates move is within bounds, in correct sub-board, and cell is empty
+ * @details Validates move is within bounds, in a playable sub-board, and cell is empty
  */
 template <typename T>
 bool Ultimate_TTT_Board<T>::update_board(Move<T>* move) {
@@ -106,43 +72,21 @@ bool Ultimate_TTT_Board<T>::update_board(Move<T>* move) {
     if (x < 0 || x >= 9 || y < 0 || y >= 9)
         return false;
 
-    int sub_x = x / 3;
-    int sub_y = y / 3;
-    int cell_x = x % 3;
-    int cell_y = y % 3;
+    int sub = (x / 3) * 3 + y / 3;
+    int cell = (x % 3) * 3 + y % 3;
 
-    if (!first_move) {
-        if (active_sub_board_x != -1 && active_sub_board_y != -1) {
-            if (!sub_board_won[active_sub_board_x][active_sub_board_y]) {
-                if (sub_x != active_sub_board_x || sub_y != active_sub_board_y)
-                    return false;
-            }
-        }
-    }
-
-    if (sub_board_won[sub_x][sub_y])
+    if (!state.is_legal(sub, cell))
         return false;
 
-    int sub_index = cell_x * 3 + cell_y;
-    if (sub_boards[sub_x][sub_y][sub_index] != T())
+    int side = side_of(symbol);
+    if (side == -1)
         return false;
 
-    sub_boards[sub_x][sub_y][sub_index] = symbol;
+    state.side = uint8_t(side);
+    state.play(sub, cell);
     this->board[x][y] = symbol;
     this->n_moves++;
 
-    update_main_board_if_won(sub_x, sub_y, symbol);
-
-    active_sub_board_x = cell_x;
-    active_sub_board_y = cell_y;
-
-    if (sub_board_won[active_sub_board_x][active_sub_board_y] ||
-        is_sub_board_full(active_sub_board_x, active_sub_board_y)) {
-        active_sub_board_x = -1;
-        active_sub_board_y = -1;
-    }
-
-    first_move = false;
     return true;
 }
 
@@ -153,8 +97,8 @@ bool Ultimate_TTT_Board<T>::update_board(Move<T>* move) {
  */
 template <typename T>
 bool Ultimate_TTT_Board<T>::is_win(Player<T>* player) {
-    T symbol = player->get_symbol();
-    return check_win_in_grid(main_board, symbol);
+    int side = find_side(player->get_symbol());
+    return side != -1 && state.has_won(side);
 }
 
 /**
@@ -174,13 +118,7 @@ bool Ultimate_TTT_Board<T>::is_lose(Player<T>* player) {
  */
 template <typename T>
 bool Ultimate_TTT_Board<T>::is_draw(Player<T>* player) {
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 3; j++) {
-            if (!sub_board_won[i][j] && !is_sub_board_full(i, j))
-                return false;
-        }
-    }
-    return !is_win(player);
+    return state.all_closed() && !is_win(player);
 }
 
 /**
@@ -200,8 +138,8 @@ bool Ultimate_TTT_Board<T>::game_is_over(Player<T>* player) {
  */
 template <typename T>
 void Ultimate_TTT_Board<T>::get_active_sub_board(int& x, int& y) const {
-    x = active_sub_board_x;
-    y = active_sub_board_y;
+    x = state.active < 0 ? -1 : state.active / 3;
+    y = state.active < 0 ? -1 : state.active % 3;
 }
 
 /**
@@ -212,7 +150,8 @@ void Ultimate_TTT_Board<T>::get_active_sub_board(int& x, int& y) const {
  */
 template <typename T>
 bool Ultimate_TTT_Board<T>::is_sub_board_won_at(int sub_x, int sub_y) const {
-    return sub_board_won[sub_x][sub_y];
+    int bit = 1 << (sub_x * 3 + sub_y);
+    return ((state.won[0] | state.won[1]) & bit) != 0;
 }
 
 /**
@@ -221,9 +160,61 @@ bool Ultimate_TTT_Board<T>::is_sub_board_won_at(int sub_x, int sub_y) const {
  */
 template <typename T>
 vector<vector<T>> Ultimate_TTT_Board<T>::get_main_board() const {
+    vector<vector<T>> main_board(3, vector<T>(3, T()));
+    for (int side = 0; side < n_sides; side++) {
+        for (int sub = 0; sub < 9; sub++) {
+            if (state.won[side] >> sub & 1)
+                main_board[sub / 3][sub % 3] = side_symbols[side];
+        }
+    }
     return main_board;
 }
 
+/**
+ * @brief Count the legal moves for the next player
+ * @return Number of empty cells in playable sub-boards
+ */
+template <typename T>
+int Ultimate_TTT_Board<T>::count_legal_moves() const {
+    return state.count_moves();
+}
+
+/**
+ * @brief Get one legal move by index
+ * @param n Index of the move, 0 <= n < count_legal_moves()
+ * @param x Reference to store the board row (0-8)
+ * @param y Reference to store the board column (0-8)
+ * @details Walks at most 9 sub-board masks with popcounts, so the cost
+ *          does not depend on how full the board is.
+ */
+template <typename T>
+void Ultimate_TTT_Board<T>::get_legal_move(int n, int& x, int& y) const {
+    int move = state.nth_move(n);
+    int sub = move / 9;
+    int cell = move % 9;
+    x = (sub / 3) * 3 + cell / 3;
+    y = (sub % 3) * 3 + cell % 3;
+}
+
+/**
+ * @brief List every legal move for the next player
+ * @return Board (row, column) pairs of all legal moves
+ */
+template <typename T>
+vector<pair<int, int>> Ultimate_TTT_Board<T>::get_legal_moves() const {
+    uint8_t moves[81];
+    int count = state.generate_moves(moves);
+
+    vector<pair<int, int>> result;
+    result.reserve(count);
+    for (int i = 0; i < count; i++) {
+        int sub = moves[i] / 9;
+        int cell = moves[i] % 9;
+        result.emplace_back((sub / 3) * 3 + cell / 3, (sub % 3) * 3 + cell % 3);
+    }
+    return result;
+}
+
 // ============================================================================
 // Ultimate_TTT_UI Implementation
 // ============================================================================
@@ -275,7 +266,8 @@ void Ultimate_TTT_UI<T>::display_board_matrix(const vector<vector<T>>& matrix) c
  * @param player Pointer to current player (human or computer)
  * @return Pointer to Move object containing position and symbol
  * @details For human players: prompts for input and validates against active sub-board
- *          For computer players: generates random valid move
+ *          For computer players: picks a random move from the legal move list
+ *          For AI players: runs the MCTS search
  */
 template <typename T>
 Move<T>* Ultimate_TTT_UI<T>::get_move(Player<T>* player) {
@@ -292,6 +284,27 @@ Move<T>* Ultimate_TTT_UI<T>::get_move(Player<T>* player) {
         cout << "\n[INFO] You can play in any available sub-board!\n";
     }
 
+    if (Ultimate_TTT_AlphaBeta_Player<T>* ai = dynamic_cast<Ultimate_TTT_AlphaBeta_Player<T>*>(player)) {
+        Move<T>* move = ai->get_move();
+        const Ultimate_TTT_AlphaBeta_Stats& stats = ai->get_stats();
+        cout << "[ALPHA-BETA] " << player->get_name() << " plays at (" << move->get_x() << ","
+             << move->get_y() << ") at depth " << stats.depth << ", score " << stats.score
+             << ", " << stats.nodes << " nodes in " << int(stats.seconds * 1000) << " ms ("
+             << (long long)stats.nodes_per_second() << " nodes/s)\n";
+        return move;
+    }
+
+    if (player->get_type() == PlayerType::AI) {
+        Ultimate_TTT_MCTS_Player<T>* ai = dynamic_cast<Ultimate_TTT_MCTS_Player<T>*>(player);
+        Move<T>* move = ai->get_move();
+        const Ultimate_TTT_Search_Stats& stats = ai->get_stats();
+        cout << "[MCTS] " << player->get_name() << " plays at (" << move->get_x() << ","
+             << move->get_y() << ") after " << stats.playouts << " playouts in "
+             << int(stats.seconds * 1000) << " ms (" << (long long)stats.playouts_per_second()
+             << " playouts/s, win rate " << int(stats.best_value * 100) << "%)\n";
+        return move;
+    }
+
     if (player->get_type() == PlayerType::HUMAN) {
         int x, y;
         cout << player->get_name() << " (" << player->get_symbol() << "), enter row and column (0-8): ";
@@ -322,32 +335,780 @@ Move<T>* Ultimate_TTT_UI<T>::get_move(Player<T>* player) {
 
         return new Move<T>(x, y, player->get_symbol());
     } else {
-        // Computer player logic
-        int x, y;
-        if (active_x != -1 && active_y != -1) {
-            do {
-                int local_x = rand() % 3;
-                int local_y = rand() % 3;
-                x = active_x * 3 + local_x;
-                y = active_y * 3 + local_y;
-            } while (board->get_cell(x, y) != T());
-        } else {
-            do {
-                x = rand() % 9;
-                y = rand() % 9;
-                int sub_x = x / 3;
-                int sub_y = y / 3;
-                if (board->is_sub_board_won_at(sub_x, sub_y))
-                    continue;
-                if (board->get_cell(x, y) == T())
-                    break;
-            } while (true);
-        }
+        // Computer player logic: uniform pick among the legal moves
+        int x = -1, y = -1;
+        int count = board->count_legal_moves();
+        if (count > 0)
+            board->get_legal_move(game_random().below(count), x, y);
         cout << "[COMPUTER] " << player->get_name() << " plays at (" << x << "," << y << ")\n";
         return new Move<T>(x, y, player->get_symbol());
     }
 }
 
+/**
+ * @brief Set up both players, offering human, random and MCTS players
+ * @return Array of two Player pointers
+ */
+template <typename T>
+Player<T>** Ultimate_TTT_UI<T>::setup_players() {
+    Player<T>** players = new Player<T>*[2];
+    const char* labels[2] = { "Player X", "Player O" };
+    const char symbols[2] = { 'X', 'O' };
+
+    for (int i = 0; i < 2; i++) {
+        string name = this->get_player_name(labels[i]);
+        cout << "Choose " << labels[i] << " type:\n";
+        cout << "1. Human\n";
+        cout << "2. Random Computer\n";
+        cout << "3. Smart AI (MCTS)\n";
+        cout << "4. Smart AI (Alpha-Beta)\n";
+        cout << "Enter choice: ";
+        int choice;
+        cin >> choice;
+
+        if (choice == 4) {
+            cout << "Creating computer player: " << name << " (" << symbols[i] << ")\n";
+            players[i] = new Ultimate_TTT_AlphaBeta_Player<T>(name, static_cast<T>(symbols[i]));
+            continue;
+        }
+
+        PlayerType type = (choice == 2) ? PlayerType::COMPUTER :
+                          (choice == 3) ? PlayerType::AI : PlayerType::HUMAN;
+        players[i] = create_player(name, static_cast<T>(symbols[i]), type);
+    }
+
+    return players;
+}
+
+/**
+ * @brief Create a player object for the chosen type
+ * @param name Player name
+ * @param symbol Player symbol
+ * @param type HUMAN, COMPUTER (random) or AI (MCTS)
+ * @return Pointer to the new player
+ */
+template <typename T>
+Player<T>* Ultimate_TTT_UI<T>::create_player(string& name, T symbol, PlayerType type) {
+    if (type == PlayerType::AI) {
+        Ultimate_TTT_MCTS_Config config;
+        config.threads = max(1u, thread::hardware_concurrency());
+        return new Ultimate_TTT_MCTS_Player<T>(name, symbol, config);
+    }
+    return UI<T>::create_player(name, symbol, type);
+}
+
+// ============================================================================
+// Ultimate_TTT_MCTS Implementation
+// ============================================================================
+
+/**
+ * @brief Scramble a seed into a non-zero generator state (splitmix64)
+ */
+static constexpr uint64_t mix_seed(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x ? x : 1;
+}
+
+/**
+ * @brief Add to a tree counter
+ * @param counter Counter to update
+ * @param value Amount to add (wraps, so 1u - n subtracts n - 1)
+ * @param shared True if other threads update the tree concurrently
+ * @details A lone worker skips the locked read-modify-write.
+ */
+static inline void add_counter(atomic<uint32_t>& counter, uint32_t value, bool shared) {
+    if (shared)
+        counter.fetch_add(value, memory_order_relaxed);
+    else
+        counter.store(counter.load(memory_order_relaxed) + value, memory_order_relaxed);
+}
+
+/**
+ * @brief Construct an engine; the node arena is allocated by the first search
+ * @param config Search budget and tuning
+ * @param seed Seed for the playout random number generators
+ */
+Ultimate_TTT_MCTS::Ultimate_TTT_MCTS(const Ultimate_TTT_MCTS_Config& config, uint64_t seed)
+        : config(config), capacity(0), node_count(0), seed(seed), searches(0),
+          playouts_started(0), playouts_done(0), stop(false) {}
+
+/**
+ * @brief Next 32 random bits (xorshift64*)
+ * @param state Generator state, advanced in place
+ */
+uint32_t Ultimate_TTT_MCTS::next_random(uint64_t& state) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return uint32_t((state * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+/**
+ * @brief Reset the arena to a single expanded root node
+ * @param root Position at the root
+ * @details Reallocates the arena only when config.max_nodes changed.
+ */
+void Ultimate_TTT_MCTS::reset_tree(const Ultimate_TTT_Bitboard& root) {
+    int wanted = max(config.max_nodes, 82);
+    if (capacity != wanted) {
+        nodes.reset(new Node[wanted]);
+        capacity = wanted;
+    }
+
+    Node& r = nodes[0];
+    r.first_child.store(LEAF, memory_order_relaxed);
+    r.visits.store(0, memory_order_relaxed);
+    r.score.store(0, memory_order_relaxed);
+    r.move = 0;
+    r.n_children = 0;
+    node_count.store(1, memory_order_relaxed);
+    expand(0, root);
+}
+
+/**
+ * @brief Append one child per legal move of pos to the arena
+ * @param node Arena index of the node to expand
+ * @param pos Position at that node
+ * @return False if another thread is expanding the node or the arena is full
+ * @details The node is claimed with a compare-and-swap, and the children are
+ *          published with a release store once they are initialised.
+ */
+bool Ultimate_TTT_MCTS::expand(int node, const Ultimate_TTT_Bitboard& pos) {
+    if (node_count.load(memory_order_relaxed) + 81 > capacity)
+        return false;
+
+    int32_t expected = LEAF;
+    if (!nodes[node].first_child.compare_exchange_strong(expected, EXPANDING, memory_order_acquire))
+        return false;
+
+    uint8_t moves[81];
+    int count = pos.generate_moves(moves);
+    int first = node_count.fetch_add(count, memory_order_relaxed);
+    if (first + count > capacity) {
+        nodes[node].first_child.store(LEAF, memory_order_relaxed);
+        return false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        Node& child = nodes[first + i];
+        child.first_child.store(LEAF, memory_order_relaxed);
+        child.visits.store(0, memory_order_relaxed);
+        child.score.store(0, memory_order_relaxed);
+        child.move = moves[i];
+        child.n_children = 0;
+    }
+    nodes[node].n_children = uint8_t(count);
+    nodes[node].first_child.store(first, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Pick the child with the highest UCT score
+ * @param node Arena index of an expanded node
+ * @return Arena index of the chosen child; unvisited children come first
+ */
+int Ultimate_TTT_MCTS::select_child(int node) const {
+    const Node& parent = nodes[node];
+    int first = parent.first_child.load(memory_order_acquire);
+    double log_visits = log(double(max(parent.visits.load(memory_order_relaxed), 1u)));
+    int best = first;
+    double best_score = -1;
+
+    for (int c = first; c < first + parent.n_children; c++) {
+        uint32_t visits = nodes[c].visits.load(memory_order_relaxed);
+        if (visits == 0)
+            return c;
+        double score = nodes[c].score.load(memory_order_relaxed) / (2.0 * visits) +
+                       config.exploration * sqrt(log_visits / visits);
+        if (score > best_score) {
+            best_score = score;
+            best = c;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Play uniformly random legal moves until the game ends
+ * @param pos Starting position (copied)
+ * @param rng Generator state of the calling worker
+ * @return Result for side 0: 2 win, 1 draw, 0 loss
+ */
+uint32_t Ultimate_TTT_MCTS::playout(Ultimate_TTT_Bitboard pos, uint64_t& rng) {
+    while (!pos.is_terminal()) {
+        // Multiply-shift maps 32 random bits onto [0, count) without division
+        int count = pos.count_moves();
+        int move = pos.nth_move(int((uint64_t(next_random(rng)) * count) >> 32));
+        pos.play(move / 9, move % 9);
+    }
+    if (pos.has_won(0)) return 2;
+    if (pos.has_won(1)) return 0;
+    return 1;
+}
+
+/**
+ * @brief Run select / expand / playout / backpropagate until the budget runs out
+ * @param root Position at the root of the tree
+ * @param rng_seed Seed for this worker's generator
+ * @param start Time the search started
+ * @param virtual_loss Visits charged to a path while its playout runs
+ * @details A virtual loss is a visit without a win, so other workers see the
+ *          path as worse and spread out; backpropagation replaces it with the
+ *          real result.
+ */
+void Ultimate_TTT_MCTS::run_worker(const Ultimate_TTT_Bitboard& root, uint64_t rng_seed,
+                                   chrono::steady_clock::time_point start, uint32_t virtual_loss) {
+    uint64_t rng = mix_seed(rng_seed);
+    bool shared = config.threads > 1;
+    int path[82];
+    long long local = 0;
+
+    while (!stop.load(memory_order_relaxed)) {
+        if (shared ? playouts_started.fetch_add(1, memory_order_relaxed) >= config.max_playouts
+                   : local >= config.max_playouts)
+            break;
+        if (config.time_limit_ms > 0 && (local & 63) == 0) {
+            auto elapsed = chrono::steady_clock::now() - start;
+            if (chrono::duration_cast<chrono::milliseconds>(elapsed).count() >= config.time_limit_ms) {
+                stop.store(true, memory_order_relaxed);
+                break;
+            }
+        }
+
+        // Selection: descend through expanded nodes
+        Ultimate_TTT_Bitboard pos = root;
+        int depth = 0;
+        int node = 0;
+        path[depth++] = node;
+        add_counter(nodes[node].visits, virtual_loss, shared);
+        while (nodes[node].first_child.load(memory_order_acquire) >= 0) {
+            node = select_child(node);
+            pos.play(nodes[node].move / 9, nodes[node].move % 9);
+            add_counter(nodes[node].visits, virtual_loss, shared);
+            path[depth++] = node;
+        }
+
+        // Expansion: grow a leaf once it has been visited before
+        if (!pos.is_terminal() && nodes[node].visits.load(memory_order_relaxed) > virtual_loss &&
+            expand(node, pos)) {
+            node = select_child(node);
+            pos.play(nodes[node].move / 9, nodes[node].move % 9);
+            add_counter(nodes[node].visits, virtual_loss, shared);
+            path[depth++] = node;
+        }
+
+        // Simulation and backpropagation; node at depth d was played by root.side ^ ((d - 1) & 1)
+        uint32_t result = playout(pos, rng);
+        add_counter(nodes[0].visits, 1u - virtual_loss, shared);
+        for (int d = 1; d < depth; d++) {
+            int mover = root.side ^ ((d - 1) & 1);
+            add_counter(nodes[path[d]].visits, 1u - virtual_loss, shared);
+            add_counter(nodes[path[d]].score, mover == 0 ? result : 2 - result, shared);
+        }
+        local++;
+    }
+
+    playouts_done.fetch_add(local, memory_order_relaxed);
+}
+
+/**
+ * @brief Search the shared tree with config.threads workers
+ * @param root Position to search
+ * @param start Time the search started
+ * @details The calling thread is one of the workers. Virtual loss is only
+ *          applied when more than one worker shares the tree.
+ */
+void Ultimate_TTT_MCTS::search_tree(const Ultimate_TTT_Bitboard& root,
+                                    chrono::steady_clock::time_point start) {
+    reset_tree(root);
+    playouts_started.store(0, memory_order_relaxed);
+    playouts_done.store(0, memory_order_relaxed);
+    stop.store(false, memory_order_relaxed);
+
+    int n_threads = max(config.threads, 1);
+    uint32_t virtual_loss = n_threads > 1 ? uint32_t(max(config.virtual_loss, 0)) : 0;
+    uint64_t base = seed + searches * 0x9E3779B97F4A7C15ull;
+
+    vector<thread> workers;
+    for (int t = 1; t < n_threads; t++)
+        workers.emplace_back(&Ultimate_TTT_MCTS::run_worker, this, cref(root),
+                             base + uint64_t(t) * 0xD1B54A32D192ED03ull, start, virtual_loss);
+    run_worker(root, base, start, virtual_loss);
+    for (thread& worker : workers)
+        worker.join();
+
+    stats.playouts = playouts_done.load(memory_order_relaxed);
+    stats.nodes = min(node_count.load(memory_order_relaxed), capacity);
+}
+
+/**
+ * @brief Search private trees on config.threads threads and sum their roots
+ * @param root Position to search
+ * @param visits Output visits per move (sub * 9 + cell)
+ * @param score Output score per move
+ * @details Each helper gets an equal share of the playout and node budgets
+ *          and the full time limit.
+ */
+void Ultimate_TTT_MCTS::search_root_parallel(const Ultimate_TTT_Bitboard& root,
+                                             uint64_t visits[81], uint64_t score[81]) {
+    int n_threads = max(config.threads, 1);
+    Ultimate_TTT_MCTS_Config helper_config = config;
+    helper_config.threads = 1;
+    helper_config.root_parallel = false;
+    helper_config.max_playouts = (config.max_playouts + n_threads - 1) / n_threads;
+    helper_config.max_nodes = config.max_nodes / n_threads;
+
+    while (int(helpers.size()) < n_threads) {
+        uint64_t helper_seed = seed + (helpers.size() + 1) * 0xD1B54A32D192ED03ull;
+        helpers.push_back(make_unique<Ultimate_TTT_MCTS>(helper_config, helper_seed));
+    }
+
+    vector<thread> workers;
+    for (int t = 0; t < n_threads; t++)
+        helpers[t]->config = helper_config;
+    for (int t = 1; t < n_threads; t++)
+        workers.emplace_back([this, t, &root] { helpers[t]->search(root); });
+    helpers[0]->search(root);
+    for (thread& worker : workers)
+        worker.join();
+
+    for (int t = 0; t < n_threads; t++) {
+        const Ultimate_TTT_MCTS& helper = *helpers[t];
+        const Node& r = helper.nodes[0];
+        int first = r.first_child.load(memory_order_relaxed);
+        for (int c = first; first >= 0 && c < first + r.n_children; c++) {
+            visits[helper.nodes[c].move] += helper.nodes[c].visits.load(memory_order_relaxed);
+            score[helper.nodes[c].move] += helper.nodes[c].score.load(memory_order_relaxed);
+        }
+        stats.playouts += helper.stats.playouts;
+        stats.nodes += helper.stats.nodes;
+    }
+}
+
+/**
+ * @brief Search a position and pick the most visited move
+ * @param root Position to search
+ * @return Move encoded as sub * 9 + cell, or -1 if the game is over
+ */
+int Ultimate_TTT_MCTS::search(const Ultimate_TTT_Bitboard& root) {
+    auto start = chrono::steady_clock::now();
+    stats = Ultimate_TTT_Search_Stats();
+    if (root.is_terminal())
+        return -1;
+    searches++;
+
+    uint64_t visits[81] = {};
+    uint64_t score[81] = {};
+    if (config.threads > 1 && config.root_parallel) {
+        search_root_parallel(root, visits, score);
+    } else {
+        search_tree(root, start);
+        const Node& r = nodes[0];
+        int first = r.first_child.load(memory_order_relaxed);
+        for (int c = first; first >= 0 && c < first + r.n_children; c++) {
+            visits[nodes[c].move] = nodes[c].visits.load(memory_order_relaxed);
+            score[nodes[c].move] = nodes[c].score.load(memory_order_relaxed);
+        }
+    }
+
+    uint8_t moves[81];
+    int count = root.generate_moves(moves);
+    if (count == 0)
+        return -1;
+    int best = moves[0];
+    for (int i = 1; i < count; i++) {
+        if (visits[moves[i]] > visits[best])
+            best = moves[i];
+    }
+
+    stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    stats.best_visits = int(visits[best]);
+    stats.best_value = visits[best] ? score[best] / (2.0 * visits[best]) : 0;
+    return best;
+}
+
+// ============================================================================
+// Ultimate_TTT_MCTS_Player Implementation
+// ============================================================================
+
+/**
+ * @brief Constructor for MCTS player
+ * @param name Player name
+ * @param symbol Player symbol (X or O)
+ * @param config Search budget and tuning
+ */
+template <typename T>
+Ultimate_TTT_MCTS_Player<T>::Ultimate_TTT_MCTS_Player(string name, T symbol,
+                                                      const Ultimate_TTT_MCTS_Config& config)
+        : Player<T>(name, symbol, PlayerType::AI), engine(config, game_random().next()) {}
+
+/**
+ * @brief Search the current position and return the chosen move
+ * @return Move object with position and symbol
+ */
+template <typename T>
+Move<T>* Ultimate_TTT_MCTS_Player<T>::get_move() {
+    Ultimate_TTT_Board<T>* board = dynamic_cast<Ultimate_TTT_Board<T>*>(this->boardPtr);
+    int move = engine.search(board->get_bitboard());
+    if (move < 0)
+        return new Move<T>(-1, -1, this->symbol);
+
+    int sub = move / 9;
+    int cell = move % 9;
+    return new Move<T>((sub / 3) * 3 + cell / 3, (sub % 3) * 3 + cell % 3, this->symbol);
+}
+
+// ============================================================================
+// Ultimate_TTT_AlphaBeta Implementation
+// ============================================================================
+
+/// Rows, columns and diagonals of a 3x3 grid as 9-bit masks
+static constexpr uint16_t GRID_LINES[8] = { 0x007, 0x038, 0x1C0, 0x049, 0x092, 0x124, 0x111, 0x054 };
+
+/// Value of an unblocked line by the number of the owner's marks on it
+static constexpr int LINE_WEIGHT[4] = { 0, 1, 6, 0 };
+
+/// Weight of each sub-board's threat score, by its square on the main board
+static const int SUB_BOARD_WEIGHT[9] = { 3, 2, 3, 2, 4, 2, 3, 2, 3 };
+
+/// Weight of the main board's line potential
+static const int MAIN_BOARD_WEIGHT = 25;
+
+static const int WIN_SCORE = 1000000;           ///< Score of a won game at the root
+static const int MATE_BOUND = WIN_SCORE - 100;  ///< Scores beyond this are forced wins
+static const int INF_SCORE = 2 * WIN_SCORE;     ///< Bound wider than any score
+
+static const uint8_t TT_EXACT = 0;  ///< Entry holds the exact score
+static const uint8_t TT_LOWER = 1;  ///< Entry holds a lower bound (beta cutoff)
+static const uint8_t TT_UPPER = 2;  ///< Entry holds an upper bound (no move raised alpha)
+
+/**
+ * @brief Spread a 9-bit mask into base-3 digits
+ * @return Table whose entry m is the sum of 3^i over the bits i of m
+ * @details A 3x3 grid with cells a (side 0) and b (side 1) has the base-3
+ *          index BASE3[a] + 2 * BASE3[b] in 0..3^9-1.
+ */
+static constexpr array<uint16_t, 512> make_base3_table() {
+    array<uint16_t, 512> table{};
+    for (int mask = 0; mask < 512; mask++) {
+        int value = 0;
+        for (int i = 0, power = 1; i < 9; i++, power *= 3)
+            if (mask >> i & 1)
+                value += power;
+        table[mask] = uint16_t(value);
+    }
+    return table;
+}
+
+static constexpr array<uint16_t, 512> BASE3 = make_base3_table();
+
+/**
+ * @brief Line potential of every 3x3 grid state
+ * @return Table indexed by BASE3[own] + 2 * BASE3[blocked], summing
+ *         LINE_WEIGHT over the lines with no blocked cell
+ */
+static constexpr array<int16_t, 19683> make_potential_table() {
+    array<int16_t, 19683> table{};
+    for (int index = 0; index < 19683; index++) {
+        uint16_t own = 0;
+        uint16_t blocked = 0;
+        for (int i = 0, rest = index; i < 9; i++, rest /= 3) {
+            if (rest % 3 == 1) own |= uint16_t(1u << i);
+            if (rest % 3 == 2) blocked |= uint16_t(1u << i);
+        }
+        int score = 0;
+        for (uint16_t line : GRID_LINES)
+            if ((line & blocked) == 0)
+                score += LINE_WEIGHT[popcount(uint16_t(own & line))];
+        table[index] = int16_t(score);
+    }
+    return table;
+}
+
+static constexpr array<int16_t, 19683> POTENTIAL = make_potential_table();
+
+/**
+ * @brief Threat balance of every sub-board state
+ * @return Table indexed by BASE3[side 0 cells] + 2 * BASE3[side 1 cells],
+ *         holding side 0's line potential minus side 1's
+ */
+static constexpr array<int16_t, 19683> make_sub_board_table() {
+    array<int16_t, 19683> table{};
+    for (int index = 0; index < 19683; index++) {
+        int swapped = 0;
+        for (int i = 0, rest = index, power = 1; i < 9; i++, rest /= 3, power *= 3)
+            swapped += ((3 - rest % 3) % 3) * power;
+        table[index] = int16_t(POTENTIAL[index] - POTENTIAL[swapped]);
+    }
+    return table;
+}
+
+static constexpr array<int16_t, 19683> SUB_BOARD_SCORE = make_sub_board_table();
+
+/**
+ * @brief Zobrist keys for cells, the forced sub-board and the side to move
+ */
+struct Ultimate_TTT_Zobrist {
+    uint64_t cell[2][81];  ///< Key per side per move (sub * 9 + cell)
+    uint64_t active[10];   ///< Key per forced sub-board, index 0 for "any"
+    uint64_t side;         ///< Toggled when side 1 is to move
+};
+
+static constexpr Ultimate_TTT_Zobrist make_zobrist() {
+    Ultimate_TTT_Zobrist keys{};
+    uint64_t counter = 0x5EED;
+    for (int side = 0; side < 2; side++)
+        for (int move = 0; move < 81; move++)
+            keys.cell[side][move] = mix_seed(counter++);
+    for (int i = 0; i < 10; i++)
+        keys.active[i] = mix_seed(counter++);
+    keys.side = mix_seed(counter++);
+    return keys;
+}
+
+static constexpr Ultimate_TTT_Zobrist ZOBRIST = make_zobrist();
+
+/**
+ * @brief Convert a score to the form stored in the table
+ * @details Forced-win scores count plies from the root; the table stores
+ *          them counted from the node so they stay valid at any ply.
+ */
+static int score_to_tt(int score, int ply) {
+    if (score >= MATE_BOUND) return score + ply;
+    if (score <= -MATE_BOUND) return score - ply;
+    return score;
+}
+
+/**
+ * @brief Convert a stored score back to a score counted from the root
+ */
+static int score_from_tt(int score, int ply) {
+    if (score >= MATE_BOUND) return score - ply;
+    if (score <= -MATE_BOUND) return score + ply;
+    return score;
+}
+
+/**
+ * @brief Construct an engine; the transposition table is allocated by the first search
+ * @param config Search limits
+ */
+Ultimate_TTT_AlphaBeta::Ultimate_TTT_AlphaBeta(const Ultimate_TTT_AlphaBeta_Config& config)
+        : config(config), aborted(false) {}
+
+/**
+ * @brief Static evaluation of a position
+ * @param pos Position to score
+ * @return Score for the player to move
+ * @details Main-board line potential (won sub-boards own cells, drawn ones
+ *          block both players) plus the table score of every open
+ *          sub-board weighted by its square: one lookup per sub-board.
+ */
+int Ultimate_TTT_AlphaBeta::evaluate(const Ultimate_TTT_Bitboard& pos) {
+    uint16_t dead = uint16_t(pos.closed & ~(pos.won[0] | pos.won[1]));
+    int score = MAIN_BOARD_WEIGHT *
+                (POTENTIAL[BASE3[pos.won[0]] + 2 * BASE3[pos.won[1] | dead]] -
+                 POTENTIAL[BASE3[pos.won[1]] + 2 * BASE3[pos.won[0] | dead]]);
+
+    for (uint16_t open = uint16_t(Ultimate_TTT_Bitboard::FULL & ~pos.closed); open; open &= open - 1) {
+        int sub = countr_zero(open);
+        score += SUB_BOARD_WEIGHT[sub] *
+                 SUB_BOARD_SCORE[BASE3[pos.cells[0][sub]] + 2 * BASE3[pos.cells[1][sub]]];
+    }
+    return pos.side == 0 ? score : -score;
+}
+
+/**
+ * @brief Zobrist key of a position computed from scratch
+ */
+uint64_t Ultimate_TTT_AlphaBeta::hash_position(const Ultimate_TTT_Bitboard& pos) {
+    uint64_t hash = ZOBRIST.active[pos.active + 1];
+    if (pos.side == 1)
+        hash ^= ZOBRIST.side;
+    for (int side = 0; side < 2; side++)
+        for (int sub = 0; sub < 9; sub++)
+            for (uint16_t bits = pos.cells[side][sub]; bits; bits &= bits - 1)
+                hash ^= ZOBRIST.cell[side][sub * 9 + countr_zero(bits)];
+    return hash;
+}
+
+/**
+ * @brief Zobrist key after a move, updated incrementally
+ */
+uint64_t Ultimate_TTT_AlphaBeta::hash_after(uint64_t hash, const Ultimate_TTT_Bitboard& before,
+                                            const Ultimate_TTT_Bitboard& after, int move) {
+    return hash ^ ZOBRIST.cell[before.side][move] ^ ZOBRIST.side ^
+           ZOBRIST.active[before.active + 1] ^ ZOBRIST.active[after.active + 1];
+}
+
+/**
+ * @brief Negamax search with alpha-beta pruning and transposition table
+ * @return Score for the player to move; 0 once the time limit aborts the search
+ */
+int Ultimate_TTT_AlphaBeta::negamax(const Ultimate_TTT_Bitboard& pos, uint64_t hash, int depth,
+                                    int ply, int alpha, int beta) {
+    stats.nodes++;
+    if (config.time_limit_ms > 0 && (stats.nodes & 1023) == 0) {
+        auto elapsed = chrono::steady_clock::now() - start;
+        if (chrono::duration_cast<chrono::milliseconds>(elapsed).count() >= config.time_limit_ms)
+            aborted = true;
+    }
+    if (aborted)
+        return 0;
+
+    if (pos.has_won(pos.side ^ 1))
+        return -(WIN_SCORE - ply);
+    if (pos.all_closed())
+        return 0;
+    if (depth <= 0)
+        return evaluate(pos);
+
+    TT_Entry& entry = table[hash & (table.size() - 1)];
+    int tt_move = -1;
+    if (entry.key == hash) {
+        tt_move = entry.move;
+        if (entry.depth >= depth) {
+            int score = score_from_tt(entry.score, ply);
+            if (entry.flag == TT_EXACT) return score;
+            if (entry.flag == TT_LOWER && score >= beta) return score;
+            if (entry.flag == TT_UPPER && score <= alpha) return score;
+        }
+    }
+
+    uint8_t moves[81];
+    int count = pos.generate_moves(moves);
+    if (count == 0)
+        return evaluate(pos);
+    for (int i = 1; i < count && tt_move >= 0; i++) {
+        if (moves[i] == tt_move) {
+            swap(moves[0], moves[i]);
+            break;
+        }
+    }
+
+    int original_alpha = alpha;
+    int best_score = -INF_SCORE;
+    int best_move = moves[0];
+    for (int i = 0; i < count; i++) {
+        Ultimate_TTT_Bitboard child = pos;
+        child.play(moves[i] / 9, moves[i] % 9);
+        int score = -negamax(child, hash_after(hash, pos, child, moves[i]), depth - 1, ply + 1,
+                             -beta, -alpha);
+        if (aborted)
+            return 0;
+
+        if (score > best_score) {
+            best_score = score;
+            best_move = moves[i];
+        }
+        if (score > alpha)
+            alpha = score;
+        if (alpha >= beta)
+            break;
+    }
+
+    entry.key = hash;
+    entry.score = score_to_tt(best_score, ply);
+    entry.depth = int8_t(depth);
+    entry.flag = best_score <= original_alpha ? TT_UPPER : best_score >= beta ? TT_LOWER : TT_EXACT;
+    entry.move = uint8_t(best_move);
+    return best_score;
+}
+
+/**
+ * @brief Iterative deepening from depth 1 to config.max_depth
+ * @param root Position to search
+ * @return Best move of the deepest completed iteration, or -1 if the game is over
+ * @details Each iteration searches the previous best move first. An
+ *          iteration cut short by the time limit is discarded.
+ */
+int Ultimate_TTT_AlphaBeta::search(const Ultimate_TTT_Bitboard& root) {
+    start = chrono::steady_clock::now();
+    stats = Ultimate_TTT_AlphaBeta_Stats();
+    aborted = false;
+    if (root.is_terminal())
+        return -1;
+
+    size_t size = size_t(1) << max(config.tt_bits, 1);
+    if (table.size() != size)
+        table.assign(size, TT_Entry{});
+    else
+        fill(table.begin(), table.end(), TT_Entry{});
+
+    uint64_t hash = hash_position(root);
+    uint8_t moves[81];
+    int count = root.generate_moves(moves);
+    int best_move = moves[0];
+    int best_score = 0;
+
+    for (int depth = 1; depth <= config.max_depth; depth++) {
+        uint8_t* previous_best = find(moves, moves + count, uint8_t(best_move));
+        rotate(moves, previous_best, previous_best + 1);
+
+        int alpha = -INF_SCORE;
+        int iteration_move = moves[0];
+        int iteration_score = -INF_SCORE;
+        for (int i = 0; i < count; i++) {
+            Ultimate_TTT_Bitboard child = root;
+            child.play(moves[i] / 9, moves[i] % 9);
+            int score = -negamax(child, hash_after(hash, root, child, moves[i]), depth - 1, 1,
+                                 -INF_SCORE, -alpha);
+            if (aborted)
+                break;
+            if (score > iteration_score) {
+                iteration_score = score;
+                iteration_move = moves[i];
+            }
+            alpha = max(alpha, score);
+        }
+        if (aborted)
+            break;
+
+        best_move = iteration_move;
+        best_score = iteration_score;
+        stats.depth = depth;
+        if (abs(best_score) >= MATE_BOUND)
+            break;
+    }
+
+    stats.score = best_score;
+    stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return best_move;
+}
+
+// ============================================================================
+// Ultimate_TTT_AlphaBeta_Player Implementation
+// ============================================================================
+
+/**
+ * @brief Constructor for alpha-beta player
+ * @param name Player name
+ * @param symbol Player symbol (X or O)
+ * @param config Search limits
+ */
+template <typename T>
+Ultimate_TTT_AlphaBeta_Player<T>::Ultimate_TTT_AlphaBeta_Player(string name, T symbol,
+                                                                const Ultimate_TTT_AlphaBeta_Config& config)
+        : Player<T>(name, symbol, PlayerType::AI), engine(config) {}
+
+/**
+ * @brief Search the current position and return the chosen move
+ * @return Move object with position and symbol
+ */
+template <typename T>
+Move<T>* Ultimate_TTT_AlphaBeta_Player<T>::get_move() {
+    Ultimate_TTT_Board<T>* board = dynamic_cast<Ultimate_TTT_Board<T>*>(this->boardPtr);
+    int move = engine.search(board->get_bitboard());
+    if (move < 0)
+        return new Move<T>(-1, -1, this->symbol);
+
+    int sub = move / 9;
+    int cell = move % 9;
+    return new Move<T>((sub / 3) * 3 + cell / 3, (sub % 3) * 3 + cell % 3, this->symbol);
+}
+
 // ============================================================================
 // Ultimate_TTT_Random_Player Implementation
 // ============================================================================
@@ -360,9 +1121,7 @@ Move<T>* Ultimate_TTT_UI<T>::get_move(Player<T>* player) {
  */
 template <typename T>
 Ultimate_TTT_Random_Player<T>::Ultimate_TTT_Random_Player(T symbol)
-        : Player<T>("Computer", symbol, PlayerType::RANDOM) {
-    srand(time(0));
-}
+        : Player<T>("Computer", symbol, PlayerType::RANDOM) {}
 
 // ============================================================================
 // Explicit Template Instantiations
@@ -370,4 +1129,6 @@ Ultimate_TTT_Random_Player<T>::Ultimate_TTT_Random_Player(T symbol)
 
 template class Ultimate_TTT_Board<char>;
 template class Ultimate_TTT_UI<char>;
-template class Ultimate_TTT_Random_Player<char>;
\ No newline at end of file
+template class Ultimate_TTT_Random_Player<char>;
+template class Ultimate_TTT_MCTS_Player<char>;
+template class Ultimate_TTT_AlphaBeta_Player<char>;
\ No newline at end of file
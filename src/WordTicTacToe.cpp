@@ -9,6 +9,7 @@
  */
 
 #include "WordTicTacToe.h"
+#include "Game_Random.h"
 
 // ============================================
 // WordTicTacToe_Board Implementation
@@ -424,14 +425,11 @@ Move<char>* WordTicTacToe_UI::get_move(Player<char>* player) {
  * @brief Constructs a computer-controlled random player
  * @param name Player's display name (e.g., "Computer", "AI")
  * @param symbol Player's symbol (not used in word variant but required by interface)
- * @details Initializes player as COMPUTER type and seeds random number generator
- * @note Seeds srand with current time for randomness
+ * @details Initializes player as COMPUTER type
  * @post Player is ready to generate random moves
  */
 WordTicTacToe_RandomPlayer::WordTicTacToe_RandomPlayer(const string& name, char symbol)
-        : Player<char>(name, symbol, PlayerType::COMPUTER) {
-    srand(time(0));
-}
+        : Player<char>(name, symbol, PlayerType::COMPUTER) {}
 
 /**
  * @brief Generates a random valid move for the computer player
@@ -446,7 +444,7 @@ WordTicTacToe_RandomPlayer::WordTicTacToe_RandomPlayer(const string& name, char
  *          5. Creates and returns Move object
  *
  * @throws Prints error to cerr if board is full or pointer is null
- * @note Uses rand() for randomization (seeded in constructor)
+ * @note Draws from the thread's game_random() generator
  * @note Prints move to console for transparency
  * @warning Caller must delete returned Move pointer
  * @pre Board pointer must be set via set_board()
@@ -476,10 +474,10 @@ Move<char>* WordTicTacToe_RandomPlayer::get_random_move() {
     if (empty_cells.empty()) return nullptr;
 
     // Select random cell
-    int idx = rand() % empty_cells.size();
+    int idx = game_random().below(empty_cells.size());
     int x = empty_cells[idx].first;
     int y = empty_cells[idx].second;
-    char letter = 'A' + (rand() % 26);
+    char letter = 'A' + game_random().below(26);
 
     cout << "[RANDOM] " << get_name() << " plays: (" << x << ", " << y << ", " << letter << ")" << endl;
     return new Move<char>(x, y, letter);
@@ -797,10 +795,10 @@ Move<char>* WordTicTacToe_SmartPlayer::get_smart_move() {
             }
         }
         if (!empty.empty()) {
-            int idx = rand() % empty.size();
+            int idx = game_random().below(empty.size());
             best_x = empty[idx].first;
             best_y = empty[idx].second;
-            best_letter = 'A' + (rand() % 26);
+            best_letter = 'A' + game_random().below(26);
         }
     }
 
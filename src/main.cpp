@@ -19,7 +19,10 @@
 #include "Pyramid_Classes.h"
 #include "SUS_Game.h"
 #include "Connect_4.h"
+#include "Game_Random.h"
 
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
 
 using namespace std;
@@ -151,11 +154,25 @@ void switch_case() {
     }
 }
 
+/**
+ * @brief Seed every game's random players
+ * @details Uses the XO_SEED environment variable if set, otherwise the clock.
+ *          The seed is printed so that a session can be replayed exactly.
+ */
+void seed_random() {
+    const char* env = getenv("XO_SEED");
+    uint64_t seed = env ? strtoull(env, nullptr, 10)
+                        : uint64_t(chrono::steady_clock::now().time_since_epoch().count());
+    Game_Random::set_seed(seed);
+    cout << "Random seed: " << seed << " (set XO_SEED to replay)\n";
+}
+
 /**
  * @brief Program entry point
  * @return 0 on successful exit
  */
 int main() {
+    seed_random();
     switch_case();
     return 0;
 }
\ No newline at end of file
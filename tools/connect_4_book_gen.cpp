@@ -0,0 +1,198 @@
+/**
+ * @file connect_4_book_gen.cpp
+ * @brief Offline generator for the Connect 4 opening book
+ * @details Enumerates every position reachable in at most `depth` moves,
+ *          merging left-right mirror images, solves the deepest layer
+ *          exactly with Connect_4_Solver and backs the scores up to the
+ *          shallower layers by negamax over the book itself, then writes
+ *          the sorted table read by Connect_4_Book.
+ *
+ *          Usage: connect_4_book_gen <depth> [output] [--threads N] [--from MOVES]
+ *
+ *          MOVES is a string of 1-based column numbers (e.g. "4453") giving
+ *          the root position; the default is the empty board. Solving the
+ *          deepest layer dominates the run time, and it grows quickly as
+ *          the depth shrinks: a book of depth 8 or more is an overnight job.
+ */
+
+#include "Connect_4.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <unordered_set>
+
+using namespace std;
+
+/** @brief One book entry: canonical key and exact score */
+struct Book_Entry {
+    uint64_t key;
+    int8_t score;
+    bool operator<(const Book_Entry& other) const { return key < other.key; }
+};
+
+/**
+ * @brief Collect the distinct positions of each layer from the root down to `depth` moves
+ * @details Winning moves are not expanded: the player always takes them,
+ *          so the positions after them are never looked up.
+ */
+static vector<vector<Connect_4_Position>> enumerate_layers(const Connect_4_Position& root, int depth) {
+    vector<vector<Connect_4_Position>> layers(depth - root.moves + 1);
+    layers[0].push_back(root.key() == root.canonical_key() ? root : root.mirrored());
+
+    for (size_t d = 0; d + 1 < layers.size(); d++) {
+        unordered_set<uint64_t> seen;
+        for (const Connect_4_Position& pos : layers[d]) {
+            if (pos.can_win_next()) continue;
+            for (int col = 0; col < Connect_4_Position::WIDTH; col++) {
+                if (!pos.can_play(col)) continue;
+                Connect_4_Position child = pos;
+                child.play(col);
+                uint64_t key = child.canonical_key();
+                if (!seen.insert(key).second) continue;
+                layers[d + 1].push_back(child.key() == key ? child : child.mirrored());
+            }
+        }
+        fprintf(stderr, "layer %d: %zu positions\n", int(root.moves + d + 1), layers[d + 1].size());
+    }
+    return layers;
+}
+
+/**
+ * @brief Solve every position of the deepest layer with a pool of solvers
+ */
+static vector<Book_Entry> solve_leaves(const vector<Connect_4_Position>& leaves, int threads) {
+    vector<Book_Entry> entries(leaves.size());
+    atomic<size_t> next{0};
+    atomic<size_t> done{0};
+    auto start = chrono::steady_clock::now();
+
+    auto worker = [&]() {
+        Connect_4_Solver solver(0); // no time limit: every entry must be exact
+        for (size_t i = next++; i < leaves.size(); i = next++) {
+            entries[i] = { leaves[i].key(), int8_t(solver.solve(leaves[i])) };
+            size_t finished = ++done;
+            if (finished % 100 == 0 || finished == leaves.size()) {
+                double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                double eta = seconds / finished * (leaves.size() - finished);
+                fprintf(stderr, "\rsolved %zu / %zu (%.0f s, about %.0f s left)   ",
+                        finished, leaves.size(), seconds, eta);
+            }
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 1; t < threads; t++) pool.emplace_back(worker);
+    worker();
+    for (thread& t : pool) t.join();
+    fprintf(stderr, "\n");
+
+    sort(entries.begin(), entries.end());
+    return entries;
+}
+
+/**
+ * @brief Score a layer from the already scored layer below it
+ */
+static vector<Book_Entry> back_up(const vector<Connect_4_Position>& layer, const vector<Book_Entry>& below) {
+    const int cells = Connect_4_Position::WIDTH * Connect_4_Position::HEIGHT;
+    vector<Book_Entry> entries;
+    entries.reserve(layer.size());
+
+    for (const Connect_4_Position& pos : layer) {
+        int score;
+        if (pos.can_win_next()) {
+            score = (cells + 1 - pos.moves) / 2;
+        } else {
+            score = Connect_4_Solver::MIN_SCORE - 100;
+            for (int col = 0; col < Connect_4_Position::WIDTH; col++) {
+                if (!pos.can_play(col)) continue;
+                Connect_4_Position child = pos;
+                child.play(col);
+                uint64_t key = child.canonical_key();
+                auto it = lower_bound(below.begin(), below.end(), Book_Entry{ key, 0 });
+                if (it == below.end() || it->key != key) {
+                    fprintf(stderr, "child %016llx of layer %d is missing from the layer below\n",
+                            (unsigned long long)key, pos.moves);
+                    exit(1);
+                }
+                score = max(score, -int(it->score));
+            }
+        }
+        entries.push_back({ pos.key(), int8_t(score) });
+    }
+
+    sort(entries.begin(), entries.end());
+    return entries;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <depth> [output] [--threads N] [--from MOVES]\n", argv[0]);
+        return 1;
+    }
+
+    int depth = atoi(argv[1]);
+    string output = "connect_4_book.bin";
+    int threads = max(1u, thread::hardware_concurrency());
+    Connect_4_Position root;
+
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--from") == 0 && i + 1 < argc) {
+            for (const char* c = argv[++i]; *c; c++) {
+                int col = *c - '1';
+                if (col < 0 || col >= Connect_4_Position::WIDTH || !root.can_play(col) ||
+                    root.is_winning_move(col)) {
+                    fprintf(stderr, "invalid move sequence: %s\n", argv[i]);
+                    return 1;
+                }
+                root.play(col);
+            }
+        } else {
+            output = argv[i];
+        }
+    }
+
+    if (depth < root.moves || depth >= Connect_4_Position::WIDTH * Connect_4_Position::HEIGHT) {
+        fprintf(stderr, "depth must be between %d and %d\n", root.moves,
+                Connect_4_Position::WIDTH * Connect_4_Position::HEIGHT - 1);
+        return 1;
+    }
+
+    vector<vector<Connect_4_Position>> layers = enumerate_layers(root, depth);
+
+    fprintf(stderr, "solving layer %d with %d threads\n", depth, threads);
+    vector<Book_Entry> below = solve_leaves(layers.back(), threads);
+    vector<Book_Entry> book = below;
+    for (int d = int(layers.size()) - 2; d >= 0; d--) {
+        below = back_up(layers[d], below);
+        book.insert(book.end(), below.begin(), below.end());
+    }
+    sort(book.begin(), book.end());
+
+    Connect_4_Book::Header header = {};
+    memcpy(header.magic, "C4BK", 4);
+    header.version = Connect_4_Book::VERSION;
+    header.depth = uint32_t(depth);
+    header.count = book.size();
+
+    ofstream file(output, ios::binary);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const Book_Entry& e : book)
+        file.write(reinterpret_cast<const char*>(&e.key), sizeof(e.key));
+    for (const Book_Entry& e : book)
+        file.write(reinterpret_cast<const char*>(&e.score), sizeof(e.score));
+    if (!file) {
+        fprintf(stderr, "failed to write %s\n", output.c_str());
+        return 1;
+    }
+
+    fprintf(stderr, "wrote %zu positions to %s (root score %d)\n",
+            book.size(), output.c_str(), int(below[0].score));
+    return 0;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file misere_table_gen.cpp
+ * @brief Generator for the Misere Tic-Tac-Toe position table (Misere_Table.h)
+ * @details Solves every position reachable with X moving first by negamax,
+ *          keeps the smallest of each group of 8 symmetric positions and
+ *          writes them as a sorted constexpr array. Making three in a row
+ *          loses; among moves with the same result the solver prefers the
+ *          quickest win and the slowest loss.
+ *
+ *          Usage: misere_table_gen [output=inc/Misere_Table.h]
+ */
+
+#include "Misere_Classes.h"
+#include <cstdio>
+#include <map>
+
+using namespace std;
+
+static const int POW3[9] = { 1, 3, 9, 27, 81, 243, 729, 2187, 6561 };
+static const int LINES[8][3] = {
+    { 0, 1, 2 }, { 3, 4, 5 }, { 6, 7, 8 },
+    { 0, 3, 6 }, { 1, 4, 7 }, { 2, 5, 8 },
+    { 0, 4, 8 }, { 2, 4, 6 }
+};
+
+/** @brief Base-3 digit of a cell */
+static int digit(int index, int cell) {
+    return index / POW3[cell] % 3;
+}
+
+/** @brief True if the stones of `side` on the board make three in a row through `cell` */
+static bool three_through(int index, int cell, int side) {
+    for (const auto& line : LINES) {
+        if (line[0] != cell && line[1] != cell && line[2] != cell) continue;
+        if (digit(index, line[0]) == side && digit(index, line[1]) == side && digit(index, line[2]) == side)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Negamax score for the player to move, with the best move
+ * @details A loss scores -(1 + empty cells left after the losing move), so
+ *          later losses and earlier wins score higher; a draw scores 0.
+ */
+static int solve(int index, int& best_cell) {
+    int empties = 0;
+    int x_count = 0;
+    for (int cell = 0; cell < 9; cell++) {
+        if (digit(index, cell) == 0) empties++;
+        if (digit(index, cell) == 1) x_count++;
+    }
+    int side = (x_count == 9 - empties - x_count) ? 1 : 2;
+
+    int best = -100;
+    best_cell = -1;
+    for (int cell = 0; cell < 9; cell++) {
+        if (digit(index, cell) != 0) continue;
+        int child = index + side * POW3[cell];
+        int score;
+        if (three_through(child, cell, side)) {
+            score = -empties;  // lost with empties - 1 cells left
+        } else if (empties == 1) {
+            score = 0;
+        } else {
+            int unused;
+            score = -solve(child, unused);
+        }
+        if (score > best) {
+            best = score;
+            best_cell = cell;
+        }
+    }
+    return best;
+}
+
+/** @brief Collects the canonical index of every reachable position that is not over */
+static void enumerate(int index, int side, map<int, uint32_t>& table) {
+    int symmetry;
+    int canonical = Misere_Solver::canonicalize(index, symmetry);
+    if (table.count(canonical)) return;
+
+    int best_cell;
+    int score = solve(canonical, best_cell);
+    int result = score > 0 ? Misere_Solver::WIN : score < 0 ? Misere_Solver::LOSS : Misere_Solver::DRAW;
+    table[canonical] = uint32_t(canonical) << 8 | uint32_t(result) << 4 | uint32_t(best_cell);
+
+    for (int cell = 0; cell < 9; cell++) {
+        if (digit(index, cell) != 0) continue;
+        int child = index + side * POW3[cell];
+        if (three_through(child, cell, side)) continue;
+        bool full = true;
+        for (int c = 0; c < 9; c++)
+            if (digit(child, c) == 0) full = false;
+        if (!full) enumerate(child, 3 - side, table);
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* output = argc > 1 ? argv[1] : "inc/Misere_Table.h";
+
+    map<int, uint32_t> table;
+    enumerate(0, 1, table);
+
+    FILE* file = fopen(output, "w");
+    if (!file) {
+        fprintf(stderr, "cannot write %s\n", output);
+        return 1;
+    }
+
+    fprintf(file, "/**\n");
+    fprintf(file, " * @file Misere_Table.h\n");
+    fprintf(file, " * @brief Perfect-play table for Misere Tic-Tac-Toe, used by Misere_Solver.\n");
+    fprintf(file, " *\n");
+    fprintf(file, " * Generated by tools/misere_table_gen.cpp; do not edit by hand.\n");
+    fprintf(file, " * Entry: canonical board index << 8 | result << 4 | best cell.\n");
+    fprintf(file, " */\n\n");
+    fprintf(file, "#ifndef MISERE_TABLE_H\n#define MISERE_TABLE_H\n\n#include <cstdint>\n\n");
+    fprintf(file, "static constexpr int MISERE_TABLE_SIZE = %zu; ///< Number of stored positions\n\n", table.size());
+    fprintf(file, "/// Positions sorted by canonical index\n");
+    fprintf(file, "static constexpr uint32_t MISERE_TABLE[MISERE_TABLE_SIZE] = {");
+    int column = 0;
+    for (const auto& entry : table) {
+        fprintf(file, "%s0x%06X,", column % 8 == 0 ? "\n    " : " ", entry.second);
+        column++;
+    }
+    fprintf(file, "\n};\n\n#endif // MISERE_TABLE_H\n");
+    fclose(file);
+
+    fprintf(stderr, "wrote %zu positions to %s\n", table.size(), output);
+    return 0;
+}